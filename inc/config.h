@@ -27,5 +27,213 @@
     #define MCU_LIB (_LIBHAL) 
 #endif
 
+/*Bus used to talk to ILI9325: GPIO bit-banging through pin.c or FSMC memory mapped bank*/
+#define _BUS_GPIO     0
+#define _BUS_FSMC     1
+
+#if !defined(ILI9325_BUS)
+#define ILI9325_BUS   (_BUS_GPIO)
+#endif
+
+/*
+ * FSMC bus settings, used only when ILI9325_BUS is _BUS_FSMC.
+ * ILI9325 CS is wired to NEx of the NOR/SRAM sub-bank, RS to one FSMC address line.
+ * Timings are in HCLK cycles (5.95 ns at 168 MHz). ILI9325 needs at least 50 ns for
+ * WR low and WR high, so ADDSET (WR high phase) and DATAST (WR low phase) default to 9.
+ */
+#if !defined(ILI9325_FSMC_BANK)
+#define ILI9325_FSMC_BANK       1    // NOR/SRAM sub-bank 1..4 (chip select NE1..NE4)
+#endif
+
+#if !defined(ILI9325_FSMC_RS_LINE)
+#define ILI9325_FSMC_RS_LINE    16   // Address line used as RS (A16..A22)
+#endif
+
+#if !defined(ILI9325_FSMC_ADDSET)
+#define ILI9325_FSMC_ADDSET     9    // Address setup phase duration, 0..15
+#endif
+
+#if !defined(ILI9325_FSMC_DATAST)
+#define ILI9325_FSMC_DATAST     9    // Data phase duration, 1..255
+#endif
+
+/*
+ * GRAM reads are much slower: RD low at least 355 ns, RD high at least 90 ns.
+ * They use separate timings (FSMC extended mode), writes keep the ones above.
+ */
+#if !defined(ILI9325_FSMC_RD_ADDSET)
+#define ILI9325_FSMC_RD_ADDSET  15   // Address setup phase duration for reads, 0..15
+#endif
+
+#if !defined(ILI9325_FSMC_RD_DATAST)
+#define ILI9325_FSMC_RD_DATAST  60   // Data phase duration for reads, 1..255
+#endif
+
+/*
+ * Extra CPU cycles (NOPs) WR is held low and high for on GPIO bus.
+ * ILI9325 requires at least 50 ns for each WR phase, the BSRR store itself
+ * takes a few cycles on AHB1, so 4 gives enough margin at 168 MHz.
+ */
+#if !defined(ILI9325_BUS_WR_NOPS)
+#define ILI9325_BUS_WR_NOPS     4
+#endif
+
+/*Extra CPU cycles (NOPs) RD is held low for on GPIO bus, GRAM read needs 355 ns*/
+#if !defined(ILI9325_BUS_RD_NOPS)
+#define ILI9325_BUS_RD_NOPS     60
+#endif
+
+/*
+ * Asynchronous fills and image blits with DMA2 memory-to-memory stream.
+ * Requires FSMC bus (DMA writes straight to the ILI9325 data address) and libopencm3.
+ * Without it async functions fall back to blocking transfers.
+ */
+#if !defined(ILI9325_USE_DMA)
+#define ILI9325_USE_DMA         0
+#endif
+
+#if !defined(ILI9325_DMA_STREAM)
+#define ILI9325_DMA_STREAM      0    // DMA2 stream 0..7
+#endif
+
+/*
+ * Solid fills with WR strobes generated by timer (TIM8 CH2 on WR pin PC7).
+ * The color is latched on the data port once, then the timer toggles WR the
+ * required amount of times while the CPU is free. GPIO bus and libopencm3 only.
+ * Fills of at least ILI9325_WR_TIMER_THRESHOLD pixels use the timer automatically.
+ * Phases are in timer clock cycles (5.95 ns at 168 MHz), 50 ns minimum each.
+ */
+#if !defined(ILI9325_USE_WR_TIMER)
+#define ILI9325_USE_WR_TIMER        0
+#endif
+
+#if !defined(ILI9325_WR_TIMER_THRESHOLD)
+#define ILI9325_WR_TIMER_THRESHOLD  256
+#endif
+
+#if !defined(ILI9325_WR_TIMER_LOW)
+#define ILI9325_WR_TIMER_LOW        9
+#endif
+
+#if !defined(ILI9325_WR_TIMER_HIGH)
+#define ILI9325_WR_TIMER_HIGH       9
+#endif
+
+/*
+ * Maximum amount of vertices of tft_fill_polygon(). Edge tables live on the stack,
+ * 16 bytes per vertex.
+ */
+#if !defined(TFT_POLYGON_POINTS_MAX)
+#define TFT_POLYGON_POINTS_MAX      64
+#endif
+
+/*
+ * Band renderer strip buffer: TFT_BAND_WIDTH x TFT_BAND_HEIGHT RGB565 pixels.
+ * Bands are as high as the buffer allows for the current screen width.
+ * TFT_BAND_ATTR places the buffer, e.g. __attribute__((section(".ccmram"))) for CCM RAM.
+ * The strip is accessed by the CPU only, so CCM is fine although DMA can't reach it.
+ * With TFT_BAND_PRELOAD each band is read back from GRAM before drawing, so pixels
+ * not touched by the draw callback keep the panel content.
+ */
+#if !defined(TFT_BAND_WIDTH)
+#define TFT_BAND_WIDTH              320
+#endif
+
+#if !defined(TFT_BAND_HEIGHT)
+#define TFT_BAND_HEIGHT             24
+#endif
+
+#if !defined(TFT_BAND_ATTR)
+#define TFT_BAND_ATTR
+#endif
+
+#if !defined(TFT_BAND_PRELOAD)
+#define TFT_BAND_PRELOAD            0
+#endif
+
+/*
+ * Dirty rectangles: TFT_DIRTY_RECTS_MAX regions are kept between flushes, when full
+ * the cheapest pair is merged. TFT_DIRTY_SETUP_COST is the cost of one more region
+ * in pixel writes: window and cursor registers (7 command/data pairs) plus the repaint
+ * call. Two regions are merged if the pixels painted extra don't exceed it.
+ */
+#if !defined(TFT_DIRTY_RECTS_MAX)
+#define TFT_DIRTY_RECTS_MAX         16
+#endif
+
+#if !defined(TFT_DIRTY_SETUP_COST)
+#define TFT_DIRTY_SETUP_COST        64
+#endif
+
+/*
+ * Depth of the clip rectangle stack of tft_push_clip().
+ */
+#if !defined(TFT_CLIP_DEPTH)
+#define TFT_CLIP_DEPTH              8
+#endif
+
+/*
+ * Pixels blended at once by tft_blend functions: background is read back and written
+ * in chunks of this size, the chunk buffer lives on the stack.
+ */
+#if !defined(TFT_BLEND_CHUNK)
+#define TFT_BLEND_CHUNK             64
+#endif
+
+/*
+ * Pixels of scaled and rotated pictures generated per burst, the buffer lives on
+ * the stack.
+ */
+#if !defined(TFT_XFORM_CHUNK)
+#define TFT_XFORM_CHUNK             64
+#endif
+
+/*
+ * Pixels of sprite background read back or composed at once, the buffer lives on
+ * the stack.
+ */
+#if !defined(TFT_SPRITE_CHUNK)
+#define TFT_SPRITE_CHUNK            64
+#endif
+
+/*
+ * Transparent text: TFT_TEXT_RUN_CACHE glyphs keep their foreground as up to
+ * TFT_TEXT_RUN_BOXES boxes. TFT_TEXT_BOX_COST is the cost of one window in pixel
+ * writes, TFT_TEXT_READ_COST the cost of reading one pixel back. A glyph is drawn as
+ * boxes unless reading its cell back in TFT_TEXT_CHUNK pixel chunks costs less.
+ */
+#if !defined(TFT_TEXT_RUN_CACHE)
+#define TFT_TEXT_RUN_CACHE          8
+#endif
+
+#if !defined(TFT_TEXT_RUN_BOXES)
+#define TFT_TEXT_RUN_BOXES          32
+#endif
+
+#if !defined(TFT_TEXT_BOX_COST)
+#define TFT_TEXT_BOX_COST           14
+#endif
+
+#if !defined(TFT_TEXT_READ_COST)
+#define TFT_TEXT_READ_COST          3
+#endif
+
+#if !defined(TFT_TEXT_CHUNK)
+#define TFT_TEXT_CHUNK              64
+#endif
+
+/*
+ * Display lists reference images in [TFT_DL_FLASH_START, TFT_DL_FLASH_END), pixels
+ * anywhere else are copied to the arena. The default is the 1 MB internal flash of
+ * STM32F407, set the range of the part used (or an empty one to always copy).
+ */
+#if !defined(TFT_DL_FLASH_START)
+#define TFT_DL_FLASH_START          0x08000000UL
+#endif
+
+#if !defined(TFT_DL_FLASH_END)
+#define TFT_DL_FLASH_END            0x08100000UL
+#endif
+
 
 
@@ -9,6 +9,7 @@
 #define COURIER_NEW_20_NORM      3
 #define UBUNTUMONO_14_NORM       4
 #define SEVEN_SEGMENT            5
+#define UBUNTU_14_PROP           6
 
 /*
  * Arrays to store images of font characters
@@ -20,6 +21,38 @@ extern const uint8_t font20_normal[];
 extern const uint8_t font14_ubuntu[];
 extern const uint8_t seven_seg_num_font[];
 
+/*
+ * Proportional fonts: every symbol has its own bitmap, which covers only its set
+ * pixels, and its own step to the next symbol.
+ */
+typedef struct {
+	uint16_t offset;			// Beginning of the bitmap in the font bitmap array
+	uint8_t  width;				// Bitmap width, each row starts from a new byte
+	uint8_t  height;			// Bitmap rows
+	uint8_t  x_ofs;				// Bitmap position in the symbol cell
+	uint8_t  y_ofs;
+	uint8_t  advance;			// Cell width, step to the next symbol
+} prop_glyph;
+
+/*Kerning pair, adjust is added to the advance of the left symbol*/
+typedef struct {
+	uint8_t left;
+	uint8_t right;
+	int8_t  adjust;
+} prop_kern;
+
+typedef struct {
+	const uint8_t    *bitmap;
+	const prop_glyph *glyphs;	// One for every symbol from first to last
+	const prop_kern  *kern;		// Sorted by left then right symbol, may be NULL
+	uint16_t kern_n;
+	uint8_t  first;				// Symbol codes of the table
+	uint8_t  last;
+	uint8_t  height;			// Cell height in pixels
+} prop_font;
+
+extern const prop_font font14_prop;
+
 /*
  * Global variables for font settings
  * */
@@ -30,6 +63,7 @@ extern  uint8_t			font_width;		 // Width in pixels
 extern  uint8_t			font_height;	 // Height in pixels
 extern  uint8_t			font_byte;		 // Amounts of bytes for one sumbol
 extern  uint8_t			offset_char;	 // Offset to the beginning of the symbol table
+extern const prop_font	*font_prop;		 // Proportional font or NULL for fixed fonts
 
 
 #endif /* TFT_DISPLAY_FONTS_FONTS_H_ */
@@ -33,6 +33,16 @@ struct display_setings {
 /*Display orientation*/
 extern struct display_setings disp_orient;
 
+/*
+ * ili9325_frame_cache_stats
+ * @hits: window and cursor register writes skipped because the value was already set
+ * @misses: window and cursor register writes sent to the controller
+ */
+struct ili9325_frame_cache_stats {
+	uint32_t hits;
+	uint32_t misses;
+};
+
 /*Pointers to delay function*/
 extern void (*ili9325_ptr_delay_ms)(uint32_t delay);
 
@@ -45,6 +55,16 @@ tft_err ili9325_set_frame(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2);
 tft_err ili9325_rotate_screen(uint16_t rot_degrees);
 void ili9325_frame_draw_pixel(uint16_t color);
 void ili9325_screen_reset(void);
+tft_err ili9325_set_scroll(uint16_t lines);
+void ili9325_write_pixels_begin(void);
+void ili9325_write_pixels_end(void);
+void ili9325_write_pixels_handover(void);
+void ili9325_write_pixels(const uint16_t *src, uint32_t n);
+void ili9325_fill_pixels(uint16_t color, uint32_t n);
+tft_err ili9325_read_pixels(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst);
+void ili9325_frame_cache_invalidate(void);
+void ili9325_frame_cache_get_stats(struct ili9325_frame_cache_stats *stats);
+void ili9325_frame_cache_reset_stats(void);
 
 
 
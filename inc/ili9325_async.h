@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ili9325.h"
+
+/**
+ * ili9325 lib asynchronous pixel transfers.
+ *
+ * Pixels are streamed to the current frame (set by :c:func:`ili9325_set_frame`) while
+ * the CPU is free for other work. Any other access to the controller waits for the
+ * running transfer to finish.
+ */
+
+/*Transfers run in background only with DMA or WR strobe timer, otherwise nothing to wait for*/
+#define ILI9325_ASYNC   (ILI9325_USE_DMA || ILI9325_USE_WR_TIMER)
+
+/*Completion callback, called from interrupt context when the transfer is done*/
+typedef void (*ili9325_async_cb)(void);
+
+/*Function prototypes, for more info refer to ili9325_async.c*/
+void ili9325_async_init(void);
+tft_err ili9325_fill_pixels_async(uint16_t color, uint32_t n, ili9325_async_cb done);
+tft_err ili9325_write_pixels_async(const uint16_t *src, uint32_t n, ili9325_async_cb done);
+bool ili9325_is_busy(void);
+tft_err ili9325_async_result(void);
+void ili9325_wait_idle(void);
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "pin.h"
+
+/**
+ * ili9325 lib bus layer.
+ *
+ * Header-inline primitives that put commands and data on the ILI9325 bus.
+ * For GPIO bus every edge is a single store to BSRR with the mask folded at compile
+ * time from pin.h (ports, pins and inversions), so pin.h stays the only place to
+ * configure the wiring. All control pins live in PORT_CTRL, which lets RS and CS change
+ * in one combined set/reset write.
+ * For FSMC bus command and data registers are two addresses of NOR/SRAM bank.
+ * Every register access goes through BUS_STORE() and BUS_LOAD(), host tests (test/)
+ * define them together with the register addresses to record the bus.
+ */
+
+/*Register access, plain volatile stores and loads on the target*/
+#if !defined(BUS_STORE)
+#define BUS_STORE(reg, value)   ((reg) = (value))
+#endif
+#if !defined(BUS_LOAD)
+#define BUS_LOAD(reg)           (reg)
+#endif
+
+#if ILI9325_BUS == _BUS_FSMC
+/*
+ * ILI9325 registers mapped into FSMC NOR/SRAM bank.
+ * With 16-bit memory width the FSMC drives A[n] from HADDR[n+1], hence the extra shift.
+ */
+#if !defined(ILI9325_FSMC_BASE)
+#define ILI9325_FSMC_BASE   (0x60000000UL + 0x04000000UL * (ILI9325_FSMC_BANK - 1))
+#endif
+#define ILI9325_FSMC_CMD    (*(volatile uint16_t *)(ILI9325_FSMC_BASE))
+#define ILI9325_FSMC_DATA   (*(volatile uint16_t *)(ILI9325_FSMC_BASE \
+                                                    | (1UL << (ILI9325_FSMC_RS_LINE + 1))))
+#else
+/*GPIO port base address, same mapping as ili9325_pin_port_to_gpio() but a constant*/
+#if defined(BUS_GPIO_BASE)
+	// Given by the build, e.g. host tests
+#elif MCU_LIB
+	#define BUS_GPIO_BASE(port)  (GPIOA_BASE + (GPIOB_BASE - GPIOA_BASE) * (port))
+#else
+	#define BUS_GPIO_BASE(port)  (GPIO_PORT_A_BASE + (GPIO_PORT_B_BASE - GPIO_PORT_A_BASE) * (port))
+#endif
+/*Mode, input data, output data and bit set/reset registers*/
+#define BUS_MODER(port)      (*(volatile uint32_t *)(BUS_GPIO_BASE(port) + 0x00))
+#define BUS_IDR(port)        (*(volatile uint32_t *)(BUS_GPIO_BASE(port) + 0x10))
+#define BUS_ODR(port)        (*(volatile uint32_t *)(BUS_GPIO_BASE(port) + 0x14))
+#define BUS_BSRR(port)       (*(volatile uint32_t *)(BUS_GPIO_BASE(port) + 0x18))
+
+/*BSRR word driving control pin to the level, inversion from CTRL_INVERSIONS applied*/
+#define BUS_CTRL(pin, level) \
+	((((level) ^ ((CTRL_INVERSIONS >> (pin)) & 1)) ? (1UL << (pin)) : (1UL << ((pin) + 16))))
+
+/*Precomputed control words*/
+#define BUS_SELECT_CMD       (BUS_CTRL(RS_PIN, PIN_RESET) | BUS_CTRL(CS_PIN, PIN_RESET))
+#define BUS_SELECT_DATA      (BUS_CTRL(RS_PIN, PIN_SET) | BUS_CTRL(CS_PIN, PIN_RESET))
+#define BUS_DESELECT         (BUS_CTRL(CS_PIN, PIN_SET))
+#define BUS_WR_LOW           (BUS_CTRL(WR_PIN, PIN_RESET))
+#define BUS_WR_HIGH          (BUS_CTRL(WR_PIN, PIN_SET))
+#define BUS_RD_LOW           (BUS_CTRL(RD_PIN, PIN_RESET))
+#define BUS_RD_HIGH          (BUS_CTRL(RD_PIN, PIN_SET))
+
+/*MODER values of the data port, all 16 pins are the bus*/
+#define BUS_DATA_OUTPUT      0x55555555UL
+#define BUS_DATA_INPUT       0x00000000UL
+
+/** Holds bus phase for nops cycles. Intended mainly for private use */
+inline attr_alwaysinline void ili9325_bus_hold(const int nops)
+{
+	for (int i = 0; i < nops; i++)
+		__asm__ volatile ("nop");
+}
+
+/** Holds WR phase for ILI9325_BUS_WR_NOPS cycles. Intended mainly for private use */
+inline attr_alwaysinline void ili9325_bus_wr_hold(void)
+{
+	ili9325_bus_hold(ILI9325_BUS_WR_NOPS);
+}
+
+/** Latches the value on the data port with a WR strobe. Intended mainly for private use */
+inline attr_alwaysinline void ili9325_bus_strobe(uint16_t data)
+{
+	BUS_STORE(BUS_ODR(PORT_DATA), data ^ DATA_INVERSIONS);
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_WR_LOW);
+	ili9325_bus_wr_hold();
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_WR_HIGH);
+	ili9325_bus_wr_hold();
+}
+#endif
+
+/** Sends command (register index) to the controller */
+inline attr_alwaysinline void ili9325_bus_write_cmd(uint16_t command)
+{
+#if ILI9325_BUS == _BUS_FSMC
+	BUS_STORE(ILI9325_FSMC_CMD, command);
+#else
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_SELECT_CMD);
+	ili9325_bus_strobe(command);
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_DESELECT);
+#endif
+}
+
+/** Sends single data word to the controller */
+inline attr_alwaysinline void ili9325_bus_write_data(uint16_t data)
+{
+#if ILI9325_BUS == _BUS_FSMC
+	BUS_STORE(ILI9325_FSMC_DATA, data);
+#else
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_SELECT_DATA);
+	ili9325_bus_strobe(data);
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_DESELECT);
+#endif
+}
+
+/** Selects the controller for data burst: RS high and CS low in one write */
+inline attr_alwaysinline void ili9325_bus_burst_begin(void)
+{
+#if ILI9325_BUS != _BUS_FSMC
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_SELECT_DATA);
+#endif
+}
+
+/** Sends data word inside the burst, only WR toggles */
+inline attr_alwaysinline void ili9325_bus_burst_write(uint16_t data)
+{
+#if ILI9325_BUS == _BUS_FSMC
+	BUS_STORE(ILI9325_FSMC_DATA, data);
+#else
+	ili9325_bus_strobe(data);
+#endif
+}
+
+/** Sends the same data word n times inside the burst, data port is written once */
+inline attr_alwaysinline void ili9325_bus_burst_fill(uint16_t data, uint32_t n)
+{
+#if ILI9325_BUS == _BUS_FSMC
+	while (n--) BUS_STORE(ILI9325_FSMC_DATA, data);
+#else
+	BUS_STORE(BUS_ODR(PORT_DATA), data ^ DATA_INVERSIONS);
+	while (n--) {
+		BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_WR_LOW);
+		ili9325_bus_wr_hold();
+		BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_WR_HIGH);
+		ili9325_bus_wr_hold();
+	}
+#endif
+}
+
+/** Puts data word on the bus without strobe, used when WR is driven by hardware */
+inline attr_alwaysinline void ili9325_bus_burst_latch(uint16_t data)
+{
+#if ILI9325_BUS != _BUS_FSMC
+	BUS_STORE(BUS_ODR(PORT_DATA), data ^ DATA_INVERSIONS);
+#else
+	(void)data;
+#endif
+}
+
+/** Deselects the controller after data burst */
+inline attr_alwaysinline void ili9325_bus_burst_end(void)
+{
+#if ILI9325_BUS != _BUS_FSMC
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_DESELECT);
+#endif
+}
+
+/** Turns data port to input and selects the controller for reading */
+inline attr_alwaysinline void ili9325_bus_read_begin(void)
+{
+#if ILI9325_BUS != _BUS_FSMC
+	BUS_STORE(BUS_MODER(PORT_DATA), BUS_DATA_INPUT);
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_SELECT_DATA);
+#endif
+}
+
+/** Reads data word with RD strobe, data is sampled before the rising edge */
+inline attr_alwaysinline uint16_t ili9325_bus_read(void)
+{
+#if ILI9325_BUS == _BUS_FSMC
+	return BUS_LOAD(ILI9325_FSMC_DATA);
+#else
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_RD_LOW);
+	ili9325_bus_hold(ILI9325_BUS_RD_NOPS);
+	uint16_t data = (uint16_t)BUS_LOAD(BUS_IDR(PORT_DATA)) ^ DATA_INVERSIONS;
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_RD_HIGH);
+	ili9325_bus_wr_hold();
+	return data;
+#endif
+}
+
+/** Deselects the controller and turns data port back to output */
+inline attr_alwaysinline void ili9325_bus_read_end(void)
+{
+#if ILI9325_BUS != _BUS_FSMC
+	BUS_STORE(BUS_BSRR(PORT_CTRL), BUS_DESELECT);
+	BUS_STORE(BUS_MODER(PORT_DATA), BUS_DATA_OUTPUT);
+#endif
+}
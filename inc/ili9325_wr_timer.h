@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ili9325.h"
+
+/**
+ * ili9325 lib WR strobe timer.
+ *
+ * Timer driver that generates runs of WR strobes on GPIO bus while data port holds
+ * a fixed color. The driver is reached through :c:data:`ili9325_wr_timer`, so the
+ * hardware one may be replaced by a stand-in (e.g. strobe counter on host).
+ */
+
+/*Maximum amount of strobes in one run (8-bit repetition counter of TIM8)*/
+#define ILI9325_WR_TIMER_RUN_MAX    256u
+
+/*WR strobe timer driver*/
+typedef struct {
+	void (*init)(void);              // One time setup of the timer
+	void (*attach)(void);            // Hands WR pin over to the timer, WR stays high
+	void (*start)(uint16_t strobes); // Starts run of 1..ILI9325_WR_TIMER_RUN_MAX strobes
+	void (*detach)(void);            // Returns WR pin to GPIO, WR stays high
+} ili9325_wr_timer_driver;
+
+/*Driver in use, by default :c:data:`ili9325_wr_timer_tim8`*/
+extern const ili9325_wr_timer_driver *ili9325_wr_timer;
+/*Hardware driver, TIM8 channel 2 on PC7*/
+extern const ili9325_wr_timer_driver ili9325_wr_timer_tim8;
+
+/*Function prototypes, for more info refer to ili9325_wr_timer.c and ili9325_async.c*/
+void ili9325_wr_timer_run_done(void);
@@ -18,6 +18,43 @@ inline attr_alwaysinline void __WFI(void)
 }
 
 
+/** Disables interrupts by setting PRIMASK
+ *
+ * Pending interrupts still wake the core from WFI
+ */
+inline attr_alwaysinline void __disable_irq(void)
+{
+	__asm__ volatile ("cpsid i" ::: "memory");
+}
+
+
+/** Enables interrupts by clearing PRIMASK */
+inline attr_alwaysinline void __enable_irq(void)
+{
+	__asm__ volatile ("cpsie i" ::: "memory");
+}
+
+
+/** Reads PRIMASK
+ *  @return: 1 if interrupts are disabled, 0 if enabled
+ */
+inline attr_alwaysinline uint32_t __get_PRIMASK(void)
+{
+	uint32_t result;
+	__asm__ volatile ("mrs %0, primask" : "=r" (result));
+	return result;
+}
+
+
+/** Writes PRIMASK, used to restore the value read by __get_PRIMASK()
+ *  @primask: 1 disables interrupts, 0 enables them
+ */
+inline attr_alwaysinline void __set_PRIMASK(uint32_t primask)
+{
+	__asm__ volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+
 /** WFE - Wait For Event */
 inline attr_alwaysinline void __WFE(void)
 {
@@ -14,6 +14,8 @@
 
 // macrofunctions
 #define swap(a, b) do {int16_t t = a; a = b; b = t;} while(0)
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#define max(a, b) (((a) > (b)) ? (a) : (b))
 #define sk_arr_len(array) (sizeof (array) / sizeof (*(array)))
 #define sk_arr_foreach(var, arr) \
     for (long keep = 1, cnt = 0, size = sk_arr_len(arr); \
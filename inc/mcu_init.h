@@ -18,6 +18,7 @@ enum spi_touch {
 /*Function prototypes for more info refer to mcu_init.c*/
 void clock_init(void);
 void pins_tft_init(const ili9325_pin_group* pins);
+void fsmc_tft_init(void);
 void pins_touch_init(const ili9325_pin_group* spi, const ili9325_pin* cs);
 void touch_spi_tx_rx(enum spi_touch spi, uint8_t* buffer_rx, uint8_t* buffer_tx);
 
@@ -66,6 +66,12 @@ enum ili9325_data_ctrl_ports {
 	PORT_TOUCH_CS = ili9325_PORTB
 };
 
+/*Inversion masks of bus control and data ports (bit==1 inverts corresponding pin)*/
+enum ili9325_bus_inversions {
+	CTRL_INVERSIONS = 0,
+	DATA_INVERSIONS = 0
+};
+
 
 /**
  * Represents separate GPIO pin
@@ -2,6 +2,7 @@
 #include "fonts.h"
 #include "error.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 /*
  * Colors set
@@ -24,39 +25,113 @@
 #define GRAYBLUE 		0x5458
 
 
+/*Cap styles of lines wider than 1 pixel*/
+enum tft_line_cap {
+	TFT_CAP_BUTT,		// Line ends at the end points
+	TFT_CAP_SQUARE,		// Line is extended by half of its width
+	TFT_CAP_ROUND		// Half circle at each end
+};
+
+/*Vertex of a polygon*/
+typedef struct {
+	int16_t x;
+	int16_t y;
+} tft_point;
+
+/*Rectangle, corners are inclusive*/
+typedef struct {
+	uint16_t x1, y1;	// Top left corner
+	uint16_t x2, y2;	// Bottom right corner
+} tft_rect;
+
+/*Rules of filling self intersecting polygons*/
+enum tft_fill_rule {
+	TFT_FILL_NON_ZERO,	// Inside if edges around the point don't cancel out
+	TFT_FILL_EVEN_ODD	// Inside if a ray from the point crosses odd amount of edges
+};
+
+/*Symbol of the current font, see tft_font_get_glyph()*/
+typedef struct {
+	const uint8_t *bits;	// Rows of width bits, most significant bit first, each row starts from a new byte
+	uint8_t width;			// Bitmap size
+	uint8_t height;
+	uint8_t x;				// Bitmap position in the symbol cell
+	uint8_t y;
+	uint8_t advance;		// Cell width, step to the next symbol
+} tft_glyph;
+
 /*Cursor position for tft_printf() function*/
 extern uint16_t cursor_x;
 extern uint16_t cursor_y;
 
+/*Pixel functions of the controller, swapped to redirect drawing (bands, display lists)*/
+typedef struct {
+	tft_err (*set_frame)(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2);
+	void (*fill_screen)(uint16_t color);
+	void (*frame_draw_pixel)(uint16_t color);
+	void (*write_pixels)(const uint16_t *src, uint32_t n);
+	void (*fill_pixels)(uint16_t color, uint32_t n);
+	tft_err (*read_pixels)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst);
+	tft_err (*fill_pixels_async)(uint16_t color, uint32_t n, void (*done)(void));
+	tft_err (*write_pixels_async)(const uint16_t *src, uint32_t n, void (*done)(void));
+	void (*wait_idle)(void);
+} tft_pixel_ops;
+
 /*Pointers to LCD TFT controller's functions*/
 extern tft_err (*tft_set_frame)(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2);
 extern void (*tft_fill_screen)(uint16_t color);
 extern void (*tft_frame_draw_pixel)(uint16_t color);
+extern void (*tft_write_pixels)(const uint16_t *src, uint32_t n);
+extern void (*tft_fill_pixels)(uint16_t color, uint32_t n);
+extern tft_err (*tft_read_pixels)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst);
+extern tft_err (*tft_fill_pixels_async)(uint16_t color, uint32_t n, void (*done)(void));
+extern tft_err (*tft_write_pixels_async)(const uint16_t *src, uint32_t n, void (*done)(void));
+extern void (*tft_wait_idle)(void);
 extern tft_err (*tft_rotate_screen)(uint16_t rot_degrees);
+extern tft_err (*tft_set_scroll)(uint16_t lines);
 extern void (*tft_reset)(void);
 
 /*Function prototypes, for more info refer to tft.c*/
 void tft_init(uint16_t width, uint16_t hight, uint16_t color);
 void tft_draw_line (uint16_t x1, uint16_t y1, uint16_t x2,uint16_t y2, uint8_t width, uint16_t color);
+void tft_set_line_cap(enum tft_line_cap cap);
 void tft_draw_rectangle(uint16_t x, uint16_t y,	uint16_t longX, uint16_t longY, uint8_t width, uint16_t color);
 tft_err tft_fill_rectangle(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY, uint16_t color);
 void tft_draw_circle (uint16_t x0, uint16_t y0, uint16_t radius, uint8_t  width, uint16_t color);
 void tft_fill_circle (uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color);
+void tft_fill_ellipse(uint16_t x0, uint16_t y0, uint16_t rx, uint16_t ry, uint16_t color);
+tft_err tft_fill_round_rect(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY,
+		                    uint16_t radius, uint16_t color);
 tft_err tft_draw_fast_h_lin(int16_t x, int16_t y, int16_t length, uint16_t color);
 tft_err tft_draw_fast_v_lin(int16_t x, int16_t y, int16_t length, uint16_t color);
 void tft_draw_triangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
 		               uint16_t x2, uint16_t y2, uint8_t width,  uint16_t color);
 tft_err tft_fill_triangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
 		               uint16_t x2, uint16_t y2, uint16_t color);
+tft_err tft_fill_polygon(const tft_point *pts, uint16_t n, uint16_t color);
+void tft_set_fill_rule(enum tft_fill_rule rule);
 tft_err tft_print_num(	uint16_t x, uint16_t y, uint32_t num, uint8_t len);
 tft_err tft_print_num0(uint16_t x, uint16_t y, uint32_t num, uint8_t len);
 tft_err tft_pic_from_flash(uint16_t x, uint16_t y, const uint16_t* img);
+tft_err tft_blit(int16_t dst_x, int16_t dst_y, const uint16_t *img, const tft_rect *src);
+tft_err tft_fill_rect_async(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY, uint16_t color,
+		               void (*done)(void));
+tft_err tft_blit_async(uint16_t x, uint16_t y, const uint16_t* img, void (*done)(void));
 tft_err tft_print_char(uint16_t x, uint16_t y, uint16_t ascii);
+void tft_font_get_glyph(uint16_t ascii, tft_glyph *g);
+uint16_t tft_char_advance(uint16_t ascii, uint16_t next);
 void tft_set_font(uint8_t type, uint16_t color,uint16_t back_color);
+void tft_set_text_transparent(bool transparent);
 tft_err tft_print_str(uint16_t x, uint16_t y, const char *str);
 void tft_colors_test(void);
 tft_err tft_draw_point(uint16_t w, uint16_t h, uint8_t size, uint16_t color);
 void tft_printf(const char *string, ...);
 void tft_set_cursor(uint16_t x, uint16_t y);
+tft_err tft_push_clip(const tft_rect *rect);
+tft_err tft_pop_clip(void);
+bool tft_get_clip(tft_rect *rect);
+void tft_get_pixel_ops(tft_pixel_ops *ops);
+void tft_set_pixel_ops(const tft_pixel_ops *ops);
+tft_err tft_set_console_scroll(bool enable);
 
 
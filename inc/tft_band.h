@@ -0,0 +1,19 @@
+#pragma once
+
+#include "tft.h"
+
+/**
+ * tft lib band renderer.
+ *
+ * A frame is composed in a RAM strip buffer one horizontal band at a time: the draw
+ * callback is replayed for every band with tft pixel functions redirected to the strip,
+ * then the band goes to the panel with one frame setup and one burst. Primitives that
+ * miss the band cost only their geometry.
+ */
+
+/*Frame drawing callback, replayed for every band*/
+typedef void (*tft_band_draw_cb)(void *ctx);
+
+/*Function prototypes, for more info refer to tft_band.c*/
+tft_err tft_band_render(tft_band_draw_cb draw, void *ctx);
+bool tft_band_visible(uint16_t y, uint16_t h);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "tft.h"
+#include "macro.h"
+
+/**
+ * tft lib alpha blending.
+ *
+ * Translucent fills, images and text. The background is read back with tft_read_pixels()
+ * a chunk at a time, blended in RAM and written again, so blending works on the panel
+ * (GRAM read-back) and inside tft_band_render() (strip buffer) alike.
+ * Alpha is 0 (transparent) .. 255 (opaque).
+ * Antialiased lines and circles blend with a known background color or, like the
+ * rest, with the content read back.
+ */
+
+/*Formats of alpha masks, rows start from a new byte*/
+enum tft_alpha_fmt {
+	TFT_ALPHA_A8,		// Byte per pixel
+	TFT_ALPHA_A4,		// 2 pixels per byte, the left one in the high nibble
+	TFT_ALPHA_A1		// 8 pixels per byte, most significant bit first (font glyphs)
+};
+
+/*RGB565 pixel spread to 32 bits with gaps between channels for products*/
+#define TFT_RGB_SPREAD_MASK	0x07E0F81FUL
+
+/** Spreads pixel as ----- GGGGGG ----- RRRRR ------ BBBBB
+ *  @c: RGB565 color
+ *  @return: spread color, channel * weight (up to 32) doesn't reach the next channel
+ */
+inline attr_alwaysinline uint32_t tft_rgb_spread(uint16_t c)
+{
+	return (c | (uint32_t)c << 16) & TFT_RGB_SPREAD_MASK;
+}
+
+/** Packs spread pixel back to RGB565
+ *  @x: spread color, bits out of the channels are dropped
+ *  @return: RGB565 color
+ */
+inline attr_alwaysinline uint16_t tft_rgb_pack(uint32_t x)
+{
+	x &= TFT_RGB_SPREAD_MASK;
+	return (uint16_t)(x | x >> 16);
+}
+
+/** Gets alpha of a mask pixel
+ *  @mask: alpha mask
+ *  @fmt: format of the mask
+ *  @width: mask width in pixels
+ *  @x, @y: pixel
+ *  @return: alpha 0..255
+ */
+inline attr_alwaysinline uint8_t tft_mask_alpha(const uint8_t *mask, enum tft_alpha_fmt fmt,
+		                                        uint16_t width, uint16_t x, uint16_t y)
+{
+	switch (fmt) {
+	case TFT_ALPHA_A8:
+		return mask[(uint32_t)y * width + x];
+	case TFT_ALPHA_A4: {
+		uint8_t b = mask[(uint32_t)y * ((width + 1) / 2) + x / 2];
+		return ((x & 1) ? (b & 0x0F) : (b >> 4)) * 17;
+	}
+	default:
+		return (mask[(uint32_t)y * ((width + 7) / 8) + x / 8] & (0x80 >> (x & 7))) ? 255 : 0;
+	}
+}
+
+/*Function prototypes, for more info refer to tft_blend.c*/
+uint16_t tft_blend_color(uint16_t fg, uint16_t bg, uint8_t alpha);
+tft_err tft_fill_rect_blend(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY,
+		                    uint16_t color, uint8_t alpha);
+tft_err tft_pic_blend(uint16_t x, uint16_t y, const uint16_t *img, const uint8_t *mask,
+		              enum tft_alpha_fmt fmt, uint8_t alpha);
+tft_err tft_fill_mask_blend(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *mask,
+		                    enum tft_alpha_fmt fmt, uint16_t color, uint8_t alpha);
+tft_err tft_print_char_blend(uint16_t x, uint16_t y, uint16_t ascii, uint8_t alpha);
+tft_err tft_print_str_blend(uint16_t x, uint16_t y, const char *str, uint8_t alpha);
+void tft_set_aa_background(bool read_back, uint16_t color);
+tft_err tft_draw_line_aa(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
+tft_err tft_draw_circle_aa(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "tft.h"
+
+/**
+ * tft lib dirty rectangles.
+ *
+ * Drawing code marks changed areas with :c:func:`tft_invalidate`, once per frame
+ * :c:func:`tft_dirty_flush` calls the repaint callback for every dirty region only.
+ * Close regions are merged when painting the gap is cheaper than one more window setup.
+ */
+
+/*Region repaint callback, draws everything inside the rect*/
+typedef void (*tft_dirty_repaint_cb)(const tft_rect *rect, void *ctx);
+
+/*Statistics of the last flushed frame*/
+typedef struct {
+	uint16_t regions;		// Regions repainted
+	uint32_t pixels;		// Pixels repainted
+	uint32_t dirty;			// Pixels invalidated, overlaps counted once per call
+	uint16_t invalidates;	// tft_invalidate() calls
+	uint16_t forced;		// Merges forced by the full region list
+} tft_dirty_stats;
+
+/*Function prototypes, for more info refer to tft_dirty.c*/
+void tft_dirty_set_repaint(tft_dirty_repaint_cb repaint, void *ctx);
+void tft_dirty_set_cost(uint32_t setup_cost);
+tft_err tft_invalidate(const tft_rect *rect);
+tft_err tft_dirty_flush(void);
+void tft_dirty_get_stats(tft_dirty_stats *stats);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "tft.h"
+
+/**
+ * tft lib display lists.
+ *
+ * Drawing calls made between :c:func:`tft_dl_begin` and :c:func:`tft_dl_end` are not sent
+ * to the panel but recorded as fixed-size commands in a caller provided arena. Every
+ * command is a self-contained rectangle, filled with a color or with pixels. When the
+ * list is closed, hidden commands are dropped, adjacent fills are merged and commands are
+ * sorted by position, then the list may be submitted any number of times.
+ */
+
+/*Command codes*/
+enum tft_dl_op {
+	TFT_DL_NOP = 0,		// Removed command
+	TFT_DL_FILL,		// Rectangle filled with color
+	TFT_DL_IMAGE		// Rectangle of pixels, row by row
+};
+
+/*Display list command*/
+typedef struct {
+	uint8_t op;
+	uint8_t reserved;
+	uint16_t color;			// Fill color
+	uint16_t x1, y1;		// Top left corner
+	uint16_t x2, y2;		// Bottom right corner
+	const uint16_t *src;	// Pixels of the image
+} tft_dl_cmd;
+
+/*Display list*/
+typedef struct {
+	tft_dl_cmd *cmd;		// Commands, from the arena start
+	uint32_t n;				// Amount of commands
+	uint16_t *data;			// Copied pixels, growing down from the arena end
+	bool full;				// Arena overflowed, the list is incomplete
+} tft_dl;
+
+/*Function prototypes, for more info refer to tft_dl.c*/
+tft_err tft_dl_begin(tft_dl *dl, void *arena, uint32_t size);
+tft_err tft_dl_end(tft_dl *dl);
+tft_err tft_dl_submit(const tft_dl *dl);
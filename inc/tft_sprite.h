@@ -0,0 +1,33 @@
+#pragma once
+
+#include "tft.h"
+#include "tft_blend.h"
+
+/**
+ * tft lib sprites.
+ *
+ * A sprite is a picture moving over the screen content. The background under it is
+ * read back into a RAM buffer when it is drawn and written back when it leaves, so
+ * nothing needs to be redrawn. On a move only the uncovered part of the old place is
+ * restored and only the newly covered part is read.
+ */
+
+/*Sprite, set up by tft_sprite_init()*/
+typedef struct {
+	const uint16_t *img;		// Picture of img_buffer.h format
+	const uint8_t *mask;		// Alpha mask or NULL
+	enum tft_alpha_fmt fmt;
+	bool keyed;					// Pixels of the key color are transparent
+	uint16_t key;
+	uint16_t *back;				// Saved background, width * height pixels
+	int16_t x, y;				// Top left corner on the screen
+	bool shown;
+} tft_sprite;
+
+/*Function prototypes, for more info refer to tft_sprite.c*/
+tft_err tft_sprite_init(tft_sprite *s, const uint16_t *img, uint16_t *back);
+void tft_sprite_set_key(tft_sprite *s, bool keyed, uint16_t key);
+void tft_sprite_set_mask(tft_sprite *s, const uint8_t *mask, enum tft_alpha_fmt fmt);
+tft_err tft_sprite_show(tft_sprite *s, int16_t x, int16_t y);
+tft_err tft_sprite_move(tft_sprite *s, int16_t x, int16_t y);
+tft_err tft_sprite_hide(tft_sprite *s);
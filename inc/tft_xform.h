@@ -0,0 +1,23 @@
+#pragma once
+
+#include "tft.h"
+
+/**
+ * tft lib scaled and rotated pictures.
+ *
+ * Pictures of img_buffer.h format are scaled and rotated on the fly: every screen pixel
+ * is mapped back to the picture in 16.16 fixed point, rows are generated into a buffer
+ * and sent as bursts of one frame.
+ */
+
+/*Sampling of the picture*/
+enum tft_filter {
+	TFT_FILTER_NEAREST,		// Nearest pixel, fast
+	TFT_FILTER_BILINEAR		// Weighted 4 nearest pixels, smooth
+};
+
+/*Function prototypes, for more info refer to tft_xform.c*/
+tft_err tft_blit_scaled(int16_t dst_x, int16_t dst_y, uint16_t dst_w, uint16_t dst_h,
+		                const uint16_t *img, const tft_rect *src, enum tft_filter filter);
+tft_err tft_blit_rotated(int16_t cx, int16_t cy, const uint16_t *img, const tft_rect *src,
+		                 int16_t angle, uint16_t scale, enum tft_filter filter);
@@ -8,6 +8,7 @@ uint8_t			font_width = 0;
 uint8_t			font_height = 0;
 uint8_t			font_byte = 0;
 uint8_t			offset_char = 0;
+const prop_font	*font_prop = 0;
 
 
 /******************************************************************
@@ -3484,3 +3485,362 @@ const uint8_t font14_ubuntu[] = {
 };
 
 
+/******************************************************************
+ * Font 14 Ubuntu proportional, tight bitmaps of font14_ubuntu symbols
+ * from ' ' to '~' with 1 pixel on both sides of each symbol.
+ * Height in pixels  =  20
+ ******************************************************************/
+static const uint8_t font14_prop_bitmap[] = {
+  //'!'=0x21
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0xC0, 0xC0, 0xC0,
+  //'"'=0x22
+  0xCC, 0xCC, 0xCC, 0xCC, 0xCC,
+  //'#'=0x23
+  0x33, 0x33, 0x33, 0xFF, 0x66, 0x66, 0x66, 0x66, 0xFF, 0xCC, 0xCC, 0xCC,
+  //'$'=0x24
+  0x18, 0x18, 0x3C, 0x7E, 0xC0, 0xC0, 0xE0, 0x7C, 0x0E, 0x03, 0x03, 0x83,
+  0xFE, 0x18, 0x18,
+  //'%'=0x25
+  0x70, 0x80, 0xD9, 0x00, 0xDB, 0x00, 0xDA, 0x00, 0xDE, 0x00, 0x74, 0x00,
+  0x0B, 0x80, 0x1E, 0xC0, 0x16, 0xC0, 0x36, 0xC0, 0x26, 0xC0, 0x43, 0x80,
+  //'&'=0x26
+  0x38, 0x6C, 0x6C, 0x6C, 0x28, 0x30, 0x72, 0xCA, 0xCE, 0xCE, 0xCE, 0x7B,
+  //'\''=0x27
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  //'('=0x28
+  0x08, 0x18, 0x30, 0x60, 0x60, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x60,
+  0x60, 0x30, 0x18, 0x08,
+  //')'=0x29
+  0x80, 0xC0, 0x60, 0x30, 0x30, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x30,
+  0x30, 0x60, 0xC0, 0x80,
+  //'*'=0x2A
+  0x18, 0x18, 0xDB, 0x7E, 0x3C, 0x66, 0x24,
+  //'+'=0x2B
+  0x30, 0x30, 0x30, 0xFC, 0x30, 0x30, 0x30,
+  //','=0x2C
+  0x70, 0x70, 0x30, 0x20, 0xC0,
+  //'-'=0x2D
+  0xF0,
+  //'.'=0x2E
+  0xE0, 0xE0, 0xE0,
+  //'/'=0x2F
+  0x03, 0x03, 0x06, 0x06, 0x06, 0x0C, 0x0C, 0x0C, 0x18, 0x18, 0x18, 0x30,
+  0x30, 0x30, 0x60, 0x60, 0x60, 0xC0, 0xC0,
+  //'0'=0x30
+  0x3C, 0x66, 0x42, 0xC3, 0xDB, 0xDB, 0xDB, 0xC3, 0xC3, 0x42, 0x66, 0x3C,
+  //'1'=0x31
+  0x18, 0x38, 0xF8, 0x98, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7C,
+  //'2'=0x32
+  0x7C, 0xCE, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0xC0, 0xFF,
+  //'3'=0x33
+  0xF8, 0x0E, 0x06, 0x06, 0x0C, 0x3C, 0x0E, 0x03, 0x03, 0x03, 0x06, 0xFC,
+  //'4'=0x34
+  0x0C, 0x1C, 0x3C, 0x2C, 0x4C, 0x4C, 0x8C, 0x8C, 0xFE, 0x0C, 0x0C, 0x0C,
+  //'5'=0x35
+  0x3F, 0x20, 0x20, 0x60, 0x60, 0x7C, 0x06, 0x03, 0x03, 0x03, 0x06, 0xFC,
+  //'6'=0x36
+  0x0E, 0x38, 0x60, 0x60, 0xC0, 0xFC, 0xC6, 0xC3, 0xC3, 0xC3, 0x66, 0x3C,
+  //'7'=0x37
+  0xFE, 0x06, 0x04, 0x0C, 0x08, 0x18, 0x18, 0x18, 0x10, 0x30, 0x30, 0x30,
+  //'8'=0x38
+  0x3E, 0xE7, 0xC3, 0xC3, 0xE6, 0x7C, 0x6E, 0xC7, 0xC3, 0xC3, 0xE7, 0x7C,
+  //'9'=0x39
+  0x3C, 0x66, 0xC3, 0xC3, 0xC3, 0x63, 0x3F, 0x03, 0x06, 0x06, 0x1C, 0x70,
+  //':'=0x3A
+  0xE0, 0xE0, 0xE0, 0x00, 0x00, 0x00, 0xE0, 0xE0, 0xE0,
+  //';'=0x3B
+  0x70, 0x70, 0x70, 0x00, 0x00, 0x00, 0x00, 0x70, 0x70, 0x30, 0x20, 0xC0,
+  //'<'=0x3C
+  0x07, 0x3C, 0xE0, 0xE0, 0x38, 0x0E, 0x02,
+  //'='=0x3D
+  0xFF, 0x00, 0x00, 0xFF,
+  //'>'=0x3E
+  0x80, 0xE0, 0x38, 0x0F, 0x07, 0x1C, 0xF0, 0x80,
+  //'?'=0x3F
+  0xF8, 0x0C, 0x0C, 0x0C, 0x18, 0x20, 0x60, 0x00, 0x00, 0x60, 0x60, 0x60,
+  //'@'=0x40
+  0x1E, 0x32, 0x63, 0x43, 0xCF, 0xDB, 0xDB, 0xDB, 0xDB, 0xDB, 0xCF, 0x60,
+  0x60, 0x30, 0x1E,
+  //'A'=0x41
+  0x0C, 0x00, 0x1C, 0x00, 0x16, 0x00, 0x16, 0x00, 0x32, 0x00, 0x23, 0x00,
+  0x23, 0x00, 0x63, 0x00, 0x7F, 0x00, 0x41, 0x80, 0x41, 0x80, 0xC0, 0x80,
+  //'B'=0x42
+  0xFC, 0xCE, 0xC6, 0xC6, 0xCC, 0xF8, 0xC6, 0xC3, 0xC3, 0xC3, 0xC6, 0xFC,
+  //'C'=0x43
+  0x1F, 0x31, 0x60, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x60, 0x30, 0x1F,
+  //'D'=0x44
+  0xF8, 0xC6, 0xC6, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC6, 0xC6, 0xF8,
+  //'E'=0x45
+  0xFC, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFE,
+  //'F'=0x46
+  0xFC, 0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  //'G'=0x47
+  0x1F, 0x70, 0x60, 0xC0, 0xC0, 0xC0, 0xC3, 0xC3, 0xC3, 0x63, 0x63, 0x1F,
+  //'H'=0x48
+  0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3,
+  //'I'=0x49
+  0xF0, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0xF0,
+  //'J'=0x4A
+  0x3E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x8C, 0xF8,
+  //'K'=0x4B
+  0xC3, 0xC6, 0xCC, 0xCC, 0xD8, 0xF0, 0xF8, 0xCC, 0xCC, 0xC6, 0xC3, 0xC1,
+  //'L'=0x4C
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFE,
+  //'M'=0x4D
+  0x46, 0x46, 0xA6, 0x66, 0x6A, 0xDB, 0xDB, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3,
+  //'N'=0x4E
+  0xC3, 0xE3, 0xE3, 0xF3, 0xD3, 0xDB, 0xCB, 0xCB, 0xC7, 0xC7, 0xC7, 0xC3,
+  //'O'=0x4F
+  0x3C, 0x66, 0x42, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x42, 0x66, 0x3C,
+  //'P'=0x50
+  0xFC, 0xC6, 0xC3, 0xC3, 0xC3, 0xC6, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  //'Q'=0x51
+  0x3C, 0x66, 0x42, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC2, 0x66, 0x3C,
+  0x18, 0x0C, 0x06,
+  //'R'=0x52
+  0xFC, 0xC6, 0xC3, 0xC3, 0xC3, 0xC6, 0xFC, 0xCC, 0xC6, 0xC2, 0xC3, 0xC3,
+  //'S'=0x53
+  0x7E, 0xE2, 0xC0, 0xC0, 0xE0, 0x78, 0x0E, 0x07, 0x03, 0x03, 0x87, 0xFE,
+  //'T'=0x54
+  0xFC, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  //'U'=0x55
+  0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x66, 0x3C,
+  //'V'=0x56
+  0xC0, 0xC0, 0xC0, 0xC0, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x21, 0x00,
+  0x33, 0x00, 0x33, 0x00, 0x12, 0x00, 0x1E, 0x00, 0x1E, 0x00, 0x0C, 0x00,
+  //'W'=0x57
+  0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xDB, 0xFB, 0x6A, 0xAE, 0xA6, 0x46, 0x46,
+  //'X'=0x58
+  0xC3, 0xC6, 0x64, 0x2C, 0x38, 0x18, 0x38, 0x2C, 0x64, 0x46, 0xC2, 0x83,
+  //'Y'=0x59
+  0xC0, 0xC0, 0x61, 0x80, 0x61, 0x80, 0x21, 0x00, 0x33, 0x00, 0x1E, 0x00,
+  0x1E, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00,
+  //'Z'=0x5A
+  0xFE, 0x06, 0x04, 0x0C, 0x08, 0x18, 0x30, 0x30, 0x60, 0x60, 0xC0, 0xFF,
+  //'['=0x5B
+  0xF0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xF0,
+  //'\\'=0x5C
+  0xC0, 0xC0, 0x60, 0x60, 0x60, 0x30, 0x30, 0x30, 0x18, 0x18, 0x18, 0x0C,
+  0x0C, 0x0C, 0x06, 0x06, 0x06, 0x03, 0x03,
+  //']'=0x5D
+  0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0x30, 0x30, 0x30, 0xF0,
+  //'^'=0x5E
+  0x18, 0x38, 0x2C, 0x64, 0xC6, 0xC3,
+  //'_'=0x5F
+  0xFF, 0x80,
+  //'`'=0x60
+  0x80, 0x40, 0x20,
+  //'a'=0x61
+  0x7C, 0x07, 0x03, 0x03, 0x7F, 0xC3, 0xC3, 0xC3, 0x7F,
+  //'b'=0x62
+  0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xC6, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC6,
+  0xFC,
+  //'c'=0x63
+  0x1F, 0x60, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x60, 0x1F,
+  //'d'=0x64
+  0x03, 0x03, 0x03, 0x03, 0x3F, 0x63, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x63,
+  0x3F,
+  //'e'=0x65
+  0x3C, 0xCC, 0x86, 0x86, 0xFE, 0x80, 0x80, 0x40, 0x3C,
+  //'f'=0x66
+  0x1F, 0x70, 0x60, 0x60, 0xFC, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+  0x60,
+  //'g'=0x67
+  0x3F, 0x63, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x63, 0x3F, 0x03, 0x06, 0x7C,
+  //'h'=0x68
+  0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xC6, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3,
+  0xC3,
+  //'i'=0x69
+  0x30, 0x30, 0x30, 0x00, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0x1E,
+  //'j'=0x6A
+  0x18, 0x18, 0x18, 0x00, 0xF8, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+  0x18, 0x18, 0x18, 0xF0,
+  //'k'=0x6B
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC2, 0xC4, 0xD8, 0xF0, 0xF0, 0xD8, 0xCC, 0xC6,
+  0xC3,
+  //'l'=0x6C
+  0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0x1E,
+  //'m'=0x6D
+  0xFE, 0xDB, 0xDB, 0xDB, 0xDB, 0xC3, 0xC3, 0xC3, 0xC3,
+  //'n'=0x6E
+  0xFC, 0xC6, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3,
+  //'o'=0x6F
+  0x3C, 0x66, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x66, 0x3C,
+  //'p'=0x70
+  0xFC, 0xC6, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC6, 0xFC, 0xC0, 0xC0, 0xC0,
+  //'q'=0x71
+  0x3F, 0x63, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x63, 0x3F, 0x03, 0x03, 0x03,
+  //'r'=0x72
+  0xFC, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  //'s'=0x73
+  0x7E, 0xC0, 0xC0, 0xF0, 0x3C, 0x07, 0x03, 0x83, 0xFE,
+  //'t'=0x74
+  0x60, 0x60, 0x60, 0xFC, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x3E,
+  //'u'=0x75
+  0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x63, 0x3F,
+  //'v'=0x76
+  0xC3, 0xC3, 0x66, 0x66, 0x64, 0x24, 0x3C, 0x18, 0x18,
+  //'w'=0x77
+  0xC0, 0x80, 0x40, 0x80, 0x49, 0x80, 0x4D, 0x80, 0x5D, 0x80, 0x55, 0x00,
+  0x77, 0x00, 0x73, 0x00, 0x23, 0x00,
+  //'x'=0x78
+  0xC2, 0x66, 0x2C, 0x38, 0x18, 0x3C, 0x64, 0xC6, 0x83,
+  //'y'=0x79
+  0xC3, 0xC3, 0x62, 0x62, 0x66, 0x36, 0x34, 0x1C, 0x18, 0x18, 0x10, 0xE0,
+  //'z'=0x7A
+  0x7E, 0x06, 0x0C, 0x18, 0x10, 0x30, 0x60, 0x60, 0xFE,
+  //'{'=0x7B
+  0x1E, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xC0, 0x30, 0x30, 0x30,
+  0x30, 0x30, 0x30, 0x1E,
+  //'|'=0x7C
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0,
+  //'}'=0x7D
+  0xE0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0C, 0x30, 0x30, 0x30,
+  0x30, 0x30, 0x30, 0xE0,
+  //'~'=0x7E
+  0x79, 0x80, 0xCF, 0x00
+};
+
+static const prop_glyph font14_prop_glyphs[] = {
+	// Offset, width, height, x, y, advance
+	{   0,  0,  0, 0,  0,  4},	// ' '
+	{   0,  2, 12, 1,  4,  4},	// '!'
+	{  12,  6,  5, 1,  3,  8},	// '"'
+	{  17,  8, 12, 1,  4, 10},	// '#'
+	{  29,  8, 15, 1,  3, 10},	// '$'
+	{  44, 10, 12, 1,  4, 12},	// '%'
+	{  68,  8, 12, 1,  4, 10},	// '&'
+	{  80,  2,  5, 1,  3,  4},	// '\''
+	{  85,  5, 16, 1,  3,  7},	// '('
+	{ 101,  5, 16, 1,  3,  7},	// ')'
+	{ 117,  8,  7, 1,  4, 10},	// '*'
+	{ 124,  6,  7, 1,  8,  8},	// '+'
+	{ 131,  4,  5, 1, 14,  6},	// ','
+	{ 136,  4,  1, 1, 11,  6},	// '-'
+	{ 137,  3,  3, 1, 13,  5},	// '.'
+	{ 140,  8, 19, 1,  0, 10},	// '/'
+	{ 159,  8, 12, 1,  4, 10},	// '0'
+	{ 171,  6, 12, 1,  4,  8},	// '1'
+	{ 183,  8, 12, 1,  4, 10},	// '2'
+	{ 195,  8, 12, 1,  4, 10},	// '3'
+	{ 207,  7, 12, 1,  4,  9},	// '4'
+	{ 219,  8, 12, 1,  4, 10},	// '5'
+	{ 231,  8, 12, 1,  4, 10},	// '6'
+	{ 243,  7, 12, 1,  4,  9},	// '7'
+	{ 255,  8, 12, 1,  4, 10},	// '8'
+	{ 267,  8, 12, 1,  4, 10},	// '9'
+	{ 279,  3,  9, 1,  7,  5},	// ':'
+	{ 288,  4, 12, 1,  7,  6},	// ';'
+	{ 300,  8,  7, 1,  8, 10},	// '<'
+	{ 307,  8,  4, 1,  9, 10},	// '='
+	{ 311,  8,  8, 1,  7, 10},	// '>'
+	{ 319,  6, 12, 1,  4,  8},	// '?'
+	{ 331,  8, 15, 1,  4, 10},	// '@'
+	{ 346,  9, 12, 1,  4, 11},	// 'A'
+	{ 370,  8, 12, 1,  4, 10},	// 'B'
+	{ 382,  8, 12, 1,  4, 10},	// 'C'
+	{ 394,  8, 12, 1,  4, 10},	// 'D'
+	{ 406,  7, 12, 1,  4,  9},	// 'E'
+	{ 418,  6, 12, 1,  4,  8},	// 'F'
+	{ 430,  8, 12, 1,  4, 10},	// 'G'
+	{ 442,  8, 12, 1,  4, 10},	// 'H'
+	{ 454,  4, 12, 1,  4,  6},	// 'I'
+	{ 466,  7, 12, 1,  4,  9},	// 'J'
+	{ 478,  8, 12, 1,  4, 10},	// 'K'
+	{ 490,  7, 12, 1,  4,  9},	// 'L'
+	{ 502,  8, 12, 1,  4, 10},	// 'M'
+	{ 514,  8, 12, 1,  4, 10},	// 'N'
+	{ 526,  8, 12, 1,  4, 10},	// 'O'
+	{ 538,  8, 12, 1,  4, 10},	// 'P'
+	{ 550,  8, 15, 1,  4, 10},	// 'Q'
+	{ 565,  8, 12, 1,  4, 10},	// 'R'
+	{ 577,  8, 12, 1,  4, 10},	// 'S'
+	{ 589,  6, 12, 1,  4,  8},	// 'T'
+	{ 601,  8, 12, 1,  4, 10},	// 'U'
+	{ 613, 10, 12, 1,  4, 12},	// 'V'
+	{ 637,  8, 12, 1,  4, 10},	// 'W'
+	{ 649,  8, 12, 1,  4, 10},	// 'X'
+	{ 661, 10, 12, 1,  4, 12},	// 'Y'
+	{ 685,  8, 12, 1,  4, 10},	// 'Z'
+	{ 697,  4, 16, 1,  3,  6},	// '['
+	{ 713,  8, 19, 1,  0, 10},	// '\\'
+	{ 732,  4, 16, 1,  3,  6},	// ']'
+	{ 748,  8,  6, 1,  4, 10},	// '^'
+	{ 754,  9,  1, 1, 18, 11},	// '_'
+	{ 756,  3,  3, 1,  3,  5},	// '`'
+	{ 759,  8,  9, 1,  7, 10},	// 'a'
+	{ 768,  8, 13, 1,  3, 10},	// 'b'
+	{ 781,  8,  9, 1,  7, 10},	// 'c'
+	{ 790,  8, 13, 1,  3, 10},	// 'd'
+	{ 803,  7,  9, 1,  7,  9},	// 'e'
+	{ 812,  8, 13, 1,  3, 10},	// 'f'
+	{ 825,  8, 12, 1,  7, 10},	// 'g'
+	{ 837,  8, 13, 1,  3, 10},	// 'h'
+	{ 850,  7, 13, 1,  3,  9},	// 'i'
+	{ 863,  5, 16, 1,  3,  7},	// 'j'
+	{ 879,  8, 13, 1,  3, 10},	// 'k'
+	{ 892,  7, 13, 1,  3,  9},	// 'l'
+	{ 905,  8,  9, 1,  7, 10},	// 'm'
+	{ 914,  8,  9, 1,  7, 10},	// 'n'
+	{ 923,  8,  9, 1,  7, 10},	// 'o'
+	{ 932,  8, 12, 1,  7, 10},	// 'p'
+	{ 944,  8, 12, 1,  7, 10},	// 'q'
+	{ 956,  6,  9, 1,  7,  8},	// 'r'
+	{ 965,  8,  9, 1,  7, 10},	// 's'
+	{ 974,  7, 12, 1,  4,  9},	// 't'
+	{ 986,  8,  9, 1,  7, 10},	// 'u'
+	{ 995,  8,  9, 1,  7, 10},	// 'v'
+	{1004,  9,  9, 1,  7, 11},	// 'w'
+	{1022,  8,  9, 1,  7, 10},	// 'x'
+	{1031,  8, 12, 1,  7, 10},	// 'y'
+	{1043,  7,  9, 1,  7,  9},	// 'z'
+	{1052,  7, 16, 1,  3,  9},	// '{'
+	{1068,  2, 16, 1,  3,  4},	// '|'
+	{1084,  6, 16, 1,  3,  8},	// '}'
+	{1100,  9,  2, 1, 10, 11} 	// '~'
+};
+
+static const prop_kern font14_prop_kern[] = {
+	{'A', 'T', -1},
+	{'A', 'V', -1},
+	{'A', 'W', -1},
+	{'A', 'Y', -1},
+	{'F', 'A', -1},
+	{'L', 'T', -1},
+	{'L', 'V', -1},
+	{'L', 'Y', -1},
+	{'P', 'A', -1},
+	{'T', ',', -1},
+	{'T', '.', -1},
+	{'T', 'A', -1},
+	{'T', 'a', -1},
+	{'T', 'e', -1},
+	{'T', 'o', -1},
+	{'V', 'A', -1},
+	{'V', 'a', -1},
+	{'V', 'e', -1},
+	{'V', 'o', -1},
+	{'W', 'A', -1},
+	{'Y', 'A', -1},
+	{'Y', 'a', -1},
+	{'Y', 'e', -1},
+	{'Y', 'o', -1},
+	{'r', ',', -1},
+	{'r', '.', -1}
+};
+
+const prop_font font14_prop = {
+	font14_prop_bitmap,
+	font14_prop_glyphs,
+	font14_prop_kern,
+	sizeof(font14_prop_kern) / sizeof(font14_prop_kern[0]),
+	' ',								// First symbol
+	'~',								// Last symbol
+	20									// Height in pixels
+};
+
@@ -6,28 +6,67 @@
   */
 
 #include "ili9325.h"
+#include "ili9325_bus.h"
+#include "ili9325_async.h"
 #include "macro.h"
 #include "tick.h"
+#include <stddef.h>
 
 /**
  *                                 LCD TFT CONTROLLER LIBRARY ILI9325
  *            You need to assign GPIO ports and pins in the pin.h header.
  *            Data transfers from the MCU to ILI9325 via a 16-bit bus such as i8080.
  *            You need to use 16 bit otput register for bus data.
+ *            Alternatively the bus can be driven by FSMC (ILI9325_BUS in config.h),
+ *            then only RESET pin is used from pin.h.
  */
 
+/*Set while a GRAM burst is open (RS high and CS low are held between pixels)*/
+static bool burst_open = false;
+
+/*Window (0x50..0x53) and cursor (0x20, 0x21) registers in shadow order*/
+enum frame_shadow_idx {
+	SHADOW_HSA = 0,
+	SHADOW_HEA,
+	SHADOW_VSA,
+	SHADOW_VEA,
+	SHADOW_AC_H,
+	SHADOW_AC_V,
+	SHADOW_REGS
+};
+
+static const uint8_t frame_shadow_addr[SHADOW_REGS] = {0x50, 0x51, 0x52, 0x53, 0x20, 0x21};
+/*Last values written to the window and cursor registers*/
+static uint16_t frame_shadow[SHADOW_REGS];
+/*Bit per register, set when the shadow matches the controller*/
+static uint8_t frame_shadow_valid = 0;
+/*Cursor registers are moved by the controller on every GRAM access*/
+#define SHADOW_CURSOR_MASK  ((1 << SHADOW_AC_H) | (1 << SHADOW_AC_V))
+
+static struct ili9325_frame_cache_stats frame_cache_stats = {0};
+
+/**
+ * Waits for the running async transfer, compiled out without DMA and WR timer (private)
+ */
+static inline void bus_wait_idle(void)
+{
+#if ILI9325_ASYNC
+	ili9325_wait_idle();
+#endif
+}
+
 /**
  * Sends the command byte to controller
  * @command: command code
+ *
+ * Note: closes the GRAM burst if it is open, as RS has to go low for the command.
+ * Waits for the running async transfer, if any.
  */
 static void ili9325_write_cmd(uint16_t command)
 {
-	pin_set_f_group(ili9325_ctrl_pins, RS_PIN, PIN_RESET);
-	pin_set_f_group(ili9325_ctrl_pins, CS_PIN, PIN_RESET);
-	write_port_data(ili9325_data_pins,command);
-	pin_set_f_group(ili9325_ctrl_pins, WR_PIN, PIN_RESET);
-	pin_set_f_group(ili9325_ctrl_pins, WR_PIN, PIN_SET);
-	pin_set_f_group(ili9325_ctrl_pins, CS_PIN, PIN_SET);
+	burst_open = false;
+	bus_wait_idle();
+	ili9325_bus_write_cmd(command);
 }
 
 /**
@@ -36,12 +75,9 @@ static void ili9325_write_cmd(uint16_t command)
  */
 static void ili9325_write_data16(uint32_t data)
 {
-	pin_set_f_group(ili9325_ctrl_pins, RS_PIN, PIN_SET);
-	pin_set_f_group(ili9325_ctrl_pins, CS_PIN, PIN_RESET);
-	write_port_data(ili9325_data_pins,data);
-	pin_set_f_group(ili9325_ctrl_pins, WR_PIN, PIN_RESET);
-	pin_set_f_group(ili9325_ctrl_pins, WR_PIN, PIN_SET);
-	pin_set_f_group(ili9325_ctrl_pins, CS_PIN, PIN_SET);
+	burst_open = false;
+	bus_wait_idle();
+	ili9325_bus_write_data(data);
 }
 
 /**
@@ -55,6 +91,53 @@ static void ili9325_write_reg(uint16_t registerTFT, uint16_t dataTFT)
 	ili9325_write_data16(dataTFT);
 }
 
+/**
+ * Writes window or cursor register only if it differs from the shadow copy (private)
+ * @idx: register index in the shadow
+ * @data: value to write
+ */
+static void ili9325_write_reg_shadowed(enum frame_shadow_idx idx, uint16_t data)
+{
+	if ((frame_shadow_valid & (1 << idx)) && frame_shadow[idx] == data) {
+		frame_cache_stats.hits++;
+		return;
+	}
+	frame_cache_stats.misses++;
+	ili9325_write_reg(frame_shadow_addr[idx], data);
+	frame_shadow[idx] = data;
+	frame_shadow_valid |= 1 << idx;
+}
+
+/**
+ * Drops the shadow of window and cursor registers, so next ili9325_set_frame()
+ * writes all of them.
+ * @context: must be called after the controller registers were changed bypassing
+ *           ili9325_set_frame() (reset, initialization, rotation)
+ */
+void ili9325_frame_cache_invalidate(void)
+{
+	frame_shadow_valid = 0;
+}
+
+/**
+ * Returns window and cursor registers shadow statistics
+ * @stats: pointer to the statistics to fill. Every register write skipped by the shadow
+ *         is counted as a hit, every register written to the controller as a miss
+ */
+void ili9325_frame_cache_get_stats(struct ili9325_frame_cache_stats *stats)
+{
+	*stats = frame_cache_stats;
+}
+
+/**
+ * Resets window and cursor registers shadow statistics to zero
+ */
+void ili9325_frame_cache_reset_stats(void)
+{
+	frame_cache_stats.hits = 0;
+	frame_cache_stats.misses = 0;
+}
+
 /**
  * Seting sizes for display.
  * @width: width pixels amount
@@ -79,6 +162,8 @@ void ili9325_init(void)
 	disp_orient.flag = ALBUM;
 	disp_orient.current_rot = 0;
 
+	ili9325_frame_cache_invalidate();
+	ili9325_async_init();
 	pin_set_f_group(ili9325_ctrl_pins, RESET_PIN, PIN_RESET);
 	ili9325_ptr_delay_ms(100);;
 	pin_set_f_group(ili9325_ctrl_pins, RESET_PIN, PIN_SET);
@@ -157,16 +242,19 @@ tft_err ili9325_set_frame(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2)
 		swap(w1, h1);
 		swap(w2, h2);
 	}
-	ili9325_write_reg(0x50,h1);
-	ili9325_write_reg(0x51,h2);
-	ili9325_write_reg(0x52,w1);
-	ili9325_write_reg(0x53,w2);
+	/*Only registers that differ from the last written values go to the bus*/
+	ili9325_write_reg_shadowed(SHADOW_HSA, h1);
+	ili9325_write_reg_shadowed(SHADOW_HEA, h2);
+	ili9325_write_reg_shadowed(SHADOW_VSA, w1);
+	ili9325_write_reg_shadowed(SHADOW_VEA, w2);
 	/*Positioning the cursor at the beginning of the area*/
-	ili9325_write_reg(0x20,h1);
-	ili9325_write_reg(0x21,w1);
+	ili9325_write_reg_shadowed(SHADOW_AC_H, h1);
+	ili9325_write_reg_shadowed(SHADOW_AC_V, w1);
 
 	/*Command of begining writing to GRAM(graphic memory)*/
 	ili9325_write_cmd(GRAM_R);//
+	/*Pixels written after it move the address counter*/
+	frame_shadow_valid &= ~SHADOW_CURSOR_MASK;
 
 	return TFT_EOK;
 }
@@ -182,9 +270,10 @@ void ili9325_draw_pixel(uint16_t w, uint16_t h, uint16_t color)
 	if (w >= disp_orient.width
 		|| h >= disp_orient.hight) return;
 	if(disp_orient.flag == PORTRATE) swap(w, h);
-	ili9325_write_reg(0x20,h);
-	ili9325_write_reg(0x21,w);
-	ili9325_write_reg(0x22,color);
+	ili9325_write_reg_shadowed(SHADOW_AC_H, h);
+	ili9325_write_reg_shadowed(SHADOW_AC_V, w);
+	ili9325_write_reg(GRAM_R, color);
+	frame_shadow_valid &= ~SHADOW_CURSOR_MASK;
 }
 
 
@@ -196,7 +285,108 @@ void ili9325_fill_screen(uint16_t color)
 {
 	uint32_t i = (uint32_t)(disp_orient.width)*(disp_orient.hight);
 	ili9325_set_frame(0, 0, disp_orient.width-1, disp_orient.hight-1);
-	while(i--) ili9325_write_data16(color);
+	ili9325_fill_pixels(color, i);
+}
+
+/**
+ * Opens a GRAM burst: RS is set high and CS low once for the whole pixel run.
+ * @context: call after ili9325_set_frame(), pixels are then sent with
+ *           ili9325_write_pixels(), ili9325_fill_pixels() or ili9325_frame_draw_pixel()
+ *           with a single WR strobe per pixel
+ *
+ * Note: the running async transfer is waited for here, once per burst, not per pixel.
+ */
+void ili9325_write_pixels_begin(void)
+{
+	bus_wait_idle();
+	ili9325_bus_burst_begin();
+	burst_open = true;
+}
+
+/**
+ * Closes the GRAM burst opened by ili9325_write_pixels_begin()
+ */
+void ili9325_write_pixels_end(void)
+{
+	bus_wait_idle();
+	ili9325_bus_burst_end();
+	burst_open = false;
+}
+
+/**
+ * Hands the bus over to an async transfer: the open burst is forgotten, so the next
+ * pixel opens a new one and waits for the transfer first.
+ * @context: called by ili9325_async.c when a transfer is started
+ */
+void ili9325_write_pixels_handover(void)
+{
+	burst_open = false;
+}
+
+/**
+ * Writes a run of pixels to the current frame
+ * @src: pixel colors
+ * @n: amount of pixels
+ *
+ * Note: opens and closes the burst itself if it was not opened by the caller.
+ */
+void ili9325_write_pixels(const uint16_t *src, uint32_t n)
+{
+	bool opened = burst_open;
+	if (!opened) ili9325_write_pixels_begin();
+	while (n--) ili9325_bus_burst_write(*src++);
+	if (!opened) ili9325_write_pixels_end();
+}
+
+/**
+ * Writes the same color to a run of pixels of the current frame
+ * @color: pixel color
+ * @n: amount of pixels
+ *
+ * Note: opens and closes the burst itself if it was not opened by the caller.
+ * With ILI9325_USE_WR_TIMER long fills are strobed by the timer and the function returns
+ * at once, leaving the burst open. Next access to the controller waits for the fill.
+ */
+void ili9325_fill_pixels(uint16_t color, uint32_t n)
+{
+#if ILI9325_USE_WR_TIMER
+	if (n >= ILI9325_WR_TIMER_THRESHOLD) {
+		ili9325_fill_pixels_async(color, n, NULL);
+		return;
+	}
+#endif
+	bool opened = burst_open;
+	if (!opened) ili9325_write_pixels_begin();
+	ili9325_bus_burst_fill(color, n);
+	if (!opened) ili9325_write_pixels_end();
+}
+
+/**
+ * Reads back a rectangle of pixels from GRAM
+ * @x: left coordinate
+ * @y: top coordinate
+ * @w: width of the rectangle
+ * @h: height of the rectangle
+ * @dst: buffer for w*h pixel colors, filled row by row
+ * @return: TFT_EOK if success, TFT_EWRONGARG if wrong arguments or TFT_ERANGE if the
+ *          rectangle is off the screen
+ *
+ * Note: the first word after GRAM read command is a dummy one and is dropped.
+ */
+tft_err ili9325_read_pixels(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst)
+{
+	if (dst == NULL || w == 0 || h == 0) return TFT_EWRONGARG;
+	if ((uint32_t)x + w > disp_orient.width || (uint32_t)y + h > disp_orient.hight) {
+		return TFT_ERANGE;
+	}
+	ili9325_set_frame(x, y, x + w - 1, y + h - 1);
+
+	uint32_t n = (uint32_t)w * h;
+	ili9325_bus_read_begin();
+	(void)ili9325_bus_read();
+	while (n--) *dst++ = ili9325_bus_read();
+	ili9325_bus_read_end();
+	return TFT_EOK;
 }
 
 /**
@@ -248,16 +438,38 @@ tft_err ili9325_rotate_screen(uint16_t rot_degrees)
 	default:
 		return TFT_EWRONGARG;
 	}
+	ili9325_set_scroll(0);
+	ili9325_frame_cache_invalidate();
+	return TFT_EOK;
+}
+
+/**
+ * Scrolls the base image along gate lines (y in portrait, x in album orientation)
+ * @lines: GRAM line shown on the first display line, 0 turns scrolling off
+ * @return: TFT_EOK if success or TFT_ERANGE if lines is out of the gate lines
+ */
+tft_err ili9325_set_scroll(uint16_t lines)
+{
+	uint16_t gates = max(tft_width, tft_hight);
+	if (lines >= gates) return TFT_ERANGE;
+	ili9325_write_reg(0x61, lines ? 0x0003 : 0x0001);	// Bit 1 - VLE, scrolling enable
+	ili9325_write_reg(0x6A, lines);						// VL, scrolling amount
 	return TFT_EOK;
 }
 
 /**
  * Pixel drawing for dedicated frame
  * @color: Pixel color
+ *
+ * Note: an open burst means no async transfer owns the bus, so nothing is waited for.
  */
 void ili9325_frame_draw_pixel(uint16_t color)
 {
-	ili9325_write_data16(color);
+	if (burst_open) {
+		ili9325_bus_burst_write(color);
+	} else {
+		ili9325_write_data16(color);
+	}
 }
 
 /**
@@ -265,6 +477,7 @@ void ili9325_frame_draw_pixel(uint16_t color)
  */
 void ili9325_screen_reset(void)
 {
+	ili9325_frame_cache_invalidate();
 	pin_set_f_group(ili9325_ctrl_pins, RESET_PIN, PIN_RESET);
 	ili9325_ptr_delay_ms(100);;
 	pin_set_f_group(ili9325_ctrl_pins, RESET_PIN, PIN_SET);
@@ -0,0 +1,290 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "ili9325_async.h"
+#include "ili9325_bus.h"
+#include "ili9325_wr_timer.h"
+#include "intrinsics.h"
+#include <stddef.h>
+#if ILI9325_USE_DMA
+#include <libopencm3/stm32/dma.h>
+#include <libopencm3/stm32/rcc.h>
+#include <libopencm3/cm3/nvic.h>
+#endif
+
+/**
+ *                        ASYNCHRONOUS TRANSFERS FOR ILI9325
+ * With ILI9325_USE_DMA the DMA2 memory-to-memory stream writes pixels directly to the
+ * FSMC data address. Solid fills use a fixed source address, image blits an incrementing
+ * one. Transfers longer than 65535 pixels (NDTR limit) are chained from the transfer
+ * complete interrupt. A transfer or FIFO error stops the transfer, the callback is still
+ * called and ili9325_async_result() reports the error.
+ * With ILI9325_USE_WR_TIMER solid fills on GPIO bus latch the color on the data port and
+ * let the WR strobe timer clock it into GRAM in runs, chained from the run interrupt.
+ * Otherwise the transfers are done in place and the callback is called before return.
+ */
+
+#if ILI9325_USE_DMA
+#if ILI9325_BUS != _BUS_FSMC
+	#error "ILI9325_USE_DMA requires ILI9325_BUS to be _BUS_FSMC"
+#endif
+#if MCU_LIB
+	#error "ILI9325_USE_DMA is implemented for libopencm3 only"
+#endif
+
+/*Maximum amount of items for one DMA transfer (16-bit NDTR register)*/
+#define DMA_CHUNK_MAX   65535u
+
+/*Stream interrupt handler and IRQ names for the configured stream*/
+#define _DMA_ISR(n)     dma2_stream##n##_isr
+#define _DMA_IRQ(n)     NVIC_DMA2_STREAM##n##_IRQ
+#define DMA_ISR(n)      _DMA_ISR(n)
+#define DMA_IRQ(n)      _DMA_IRQ(n)
+
+static volatile bool dma_busy = false;
+static volatile uint32_t dma_left = 0;         // Pixels left after the current chunk
+static const uint16_t *volatile dma_src = NULL; // Next image chunk, NULL for solid fill
+static volatile uint16_t dma_color;           // Fixed source for solid fills
+static volatile ili9325_async_cb dma_done = NULL;
+static volatile tft_err dma_result = TFT_EOK;
+
+/**
+ * Starts the next chunk of the current transfer (private)
+ */
+static void dma_next_chunk(void)
+{
+	uint32_t chunk = (dma_left > DMA_CHUNK_MAX) ? DMA_CHUNK_MAX : dma_left;
+	dma_left -= chunk;
+
+	if (dma_src != NULL) {
+		dma_set_peripheral_address(DMA2, ILI9325_DMA_STREAM, (uint32_t)dma_src);
+		dma_src += chunk;
+	} else {
+		dma_set_peripheral_address(DMA2, ILI9325_DMA_STREAM, (uint32_t)&dma_color);
+	}
+	dma_set_number_of_data(DMA2, ILI9325_DMA_STREAM, chunk);
+	dma_enable_stream(DMA2, ILI9325_DMA_STREAM);
+}
+
+/**
+ * Configures the stream and starts the transfer (private)
+ * @src: image to send or NULL for a solid fill with dma_color
+ * @n: amount of pixels
+ * @done: completion callback or NULL
+ */
+static void dma_start(const uint16_t *src, uint32_t n, ili9325_async_cb done)
+{
+	dma_stream_reset(DMA2, ILI9325_DMA_STREAM);
+	// In memory-to-memory mode the peripheral port is the source and
+	// the memory port is the destination
+	dma_set_transfer_mode(DMA2, ILI9325_DMA_STREAM, DMA_SxCR_DIR_MEM_TO_MEM);
+	dma_set_priority(DMA2, ILI9325_DMA_STREAM, DMA_SxCR_PL_HIGH);
+	dma_set_peripheral_size(DMA2, ILI9325_DMA_STREAM, DMA_SxCR_PSIZE_16BIT);
+	dma_set_memory_size(DMA2, ILI9325_DMA_STREAM, DMA_SxCR_MSIZE_16BIT);
+	if (src != NULL) {
+		dma_enable_peripheral_increment_mode(DMA2, ILI9325_DMA_STREAM);
+	} else {
+		dma_disable_peripheral_increment_mode(DMA2, ILI9325_DMA_STREAM);
+	}
+	// ILI9325 data register is a single address
+	dma_disable_memory_increment_mode(DMA2, ILI9325_DMA_STREAM);
+	dma_set_memory_address(DMA2, ILI9325_DMA_STREAM, (uint32_t)&ILI9325_FSMC_DATA);
+	// Direct mode is not allowed for memory-to-memory transfers
+	dma_enable_fifo_mode(DMA2, ILI9325_DMA_STREAM);
+	dma_set_fifo_threshold(DMA2, ILI9325_DMA_STREAM, DMA_SxFCR_FTH_4_4_FULL);
+	dma_enable_transfer_complete_interrupt(DMA2, ILI9325_DMA_STREAM);
+	dma_enable_transfer_error_interrupt(DMA2, ILI9325_DMA_STREAM);
+	dma_enable_fifo_error_interrupt(DMA2, ILI9325_DMA_STREAM);
+
+	dma_src = src;
+	dma_result = TFT_EOK;
+	dma_left = n;
+	dma_done = done;
+	dma_busy = true;
+	dma_next_chunk();
+}
+
+/**
+ * DMA stream interrupt handler. Chains the next chunk or completes the transfer, errors
+ * end the transfer.
+ */
+void DMA_ISR(ILI9325_DMA_STREAM)(void)
+{
+	bool error = dma_get_interrupt_flag(DMA2, ILI9325_DMA_STREAM, DMA_TEIF | DMA_FEIF | DMA_DMEIF);
+	bool complete = dma_get_interrupt_flag(DMA2, ILI9325_DMA_STREAM, DMA_TCIF);
+	dma_clear_interrupt_flags(DMA2, ILI9325_DMA_STREAM, DMA_ISR_FLAGS);
+
+	if (error) {
+		dma_disable_stream(DMA2, ILI9325_DMA_STREAM);
+		dma_left = 0;
+		dma_result = TFT_EUNKNOWN;
+	} else if (!complete) {
+		return;
+	} else if (dma_left != 0) {
+		dma_next_chunk();
+		return;
+	}
+	dma_busy = false;
+	if (dma_done != NULL) dma_done();
+}
+#endif
+
+#if ILI9325_USE_WR_TIMER
+static volatile bool tim_busy = false;
+static volatile uint32_t tim_left = 0;        // Strobes left after the current run
+static volatile ili9325_async_cb tim_done = NULL;
+
+/**
+ * Starts the next run of strobes (private)
+ */
+static void tim_next_run(void)
+{
+	uint32_t run = (tim_left > ILI9325_WR_TIMER_RUN_MAX) ? ILI9325_WR_TIMER_RUN_MAX : tim_left;
+	tim_left -= run;
+	ili9325_wr_timer->start(run);
+}
+
+/**
+ * Called by the WR strobe timer driver when its run is done.
+ * Chains the next run or completes the fill.
+ * @context: interrupt of the timer driver
+ */
+void ili9325_wr_timer_run_done(void)
+{
+	if (tim_left != 0) {
+		tim_next_run();
+		return;
+	}
+	ili9325_wr_timer->detach();
+	tim_busy = false;
+	if (tim_done != NULL) tim_done();
+}
+#endif
+
+/**
+ * Initialization of the async transfers engine
+ * @context: called from ili9325_init()
+ */
+void ili9325_async_init(void)
+{
+#if ILI9325_USE_DMA
+	rcc_periph_clock_enable(RCC_DMA2);
+	dma_stream_reset(DMA2, ILI9325_DMA_STREAM);
+	nvic_enable_irq(DMA_IRQ(ILI9325_DMA_STREAM));
+#endif
+#if ILI9325_USE_WR_TIMER
+	ili9325_wr_timer->init();
+#endif
+}
+
+/**
+ * Starts filling pixels of the current frame with a solid color
+ * @color: fill color
+ * @n: amount of pixels
+ * @done: callback called on completion (may be NULL)
+ * @return: TFT_EOK if success or TFT_EWRONGARG if n is 0
+ *
+ * Note: waits for the previous transfer if it is still running.
+ */
+tft_err ili9325_fill_pixels_async(uint16_t color, uint32_t n, ili9325_async_cb done)
+{
+	if (n == 0) return TFT_EWRONGARG;
+	ili9325_wait_idle();
+#if ILI9325_USE_DMA
+	ili9325_write_pixels_handover();
+	dma_color = color;
+	dma_start(NULL, n, done);
+#elif ILI9325_USE_WR_TIMER
+	// Bus stays selected, the next command closes it after the fill
+	ili9325_write_pixels_begin();
+	ili9325_write_pixels_handover();
+	ili9325_bus_burst_latch(color);
+	tim_left = n;
+	tim_done = done;
+	tim_busy = true;
+	ili9325_wr_timer->attach();
+	tim_next_run();
+#else
+	ili9325_fill_pixels(color, n);
+	if (done != NULL) done();
+#endif
+	return TFT_EOK;
+}
+
+/**
+ * Starts writing an image to the current frame
+ * @src: pixel colors, must stay valid until the transfer is done
+ * @n: amount of pixels
+ * @done: callback called on completion (may be NULL)
+ * @return: TFT_EOK if success or TFT_EWRONGARG if wrong arguments
+ *
+ * Note: waits for the previous transfer if it is still running.
+ */
+tft_err ili9325_write_pixels_async(const uint16_t *src, uint32_t n, ili9325_async_cb done)
+{
+	if (src == NULL || n == 0) return TFT_EWRONGARG;
+	ili9325_wait_idle();
+#if ILI9325_USE_DMA
+	ili9325_write_pixels_handover();
+	dma_start(src, n, done);
+#else
+	ili9325_write_pixels(src, n);
+	if (done != NULL) done();
+#endif
+	return TFT_EOK;
+}
+
+/**
+ * Checks whether the async transfer is running
+ * @return: true if the bus is busy with async transfer
+ */
+bool ili9325_is_busy(void)
+{
+#if ILI9325_USE_DMA
+	return dma_busy;
+#elif ILI9325_USE_WR_TIMER
+	return tim_busy;
+#else
+	return false;
+#endif
+}
+
+/**
+ * Gets the result of the last finished async transfer
+ * @return: TFT_EOK or TFT_EUNKNOWN if DMA stopped it on a transfer or FIFO error
+ */
+tft_err ili9325_async_result(void)
+{
+#if ILI9325_USE_DMA
+	return dma_result;
+#else
+	return TFT_EOK;
+#endif
+}
+
+/**
+ * Waits until the running async transfer is done.
+ * Note: Puts MCU to sleep using WFI instruction until the transfer complete interrupt.
+ * The check and WFI run with interrupts masked, so the last interrupt can't slip in
+ * between them: a pending interrupt wakes WFI and runs once PRIMASK is restored.
+ * PRIMASK of the caller is kept, so a transfer must not be waited for from a critical
+ * section. Without ILI9325_USE_DMA and ILI9325_USE_WR_TIMER it returns at once.
+ */
+void ili9325_wait_idle(void)
+{
+#if ILI9325_ASYNC
+	if (!ili9325_is_busy()) return;
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	while (ili9325_is_busy()) {
+		__WFI();
+		__set_PRIMASK(primask);
+		__disable_irq();
+	}
+	__set_PRIMASK(primask);
+#endif
+}
@@ -0,0 +1,104 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "ili9325_wr_timer.h"
+#if ILI9325_USE_WR_TIMER
+#include <libopencm3/stm32/gpio.h>
+#include <libopencm3/stm32/rcc.h>
+#include <libopencm3/stm32/timer.h>
+#include <libopencm3/cm3/nvic.h>
+#endif
+
+/**
+ *                        WR STROBE TIMER FOR ILI9325
+ * TIM8 channel 2 (PC7, AF3) runs in PWM mode 1 with one-pulse mode: each period WR is
+ * high for ILI9325_WR_TIMER_HIGH cycles, then low for ILI9325_WR_TIMER_LOW cycles and
+ * the rising edge at the counter wrap latches the pixel. The repetition counter makes one
+ * run up to 256 periods long, after the last one the counter stops at 0 with WR high.
+ * Update interrupt fires once per run and calls ili9325_wr_timer_run_done().
+ */
+
+#if ILI9325_USE_WR_TIMER
+#if ILI9325_BUS != _BUS_GPIO
+	#error "ILI9325_USE_WR_TIMER requires ILI9325_BUS to be _BUS_GPIO"
+#endif
+#if MCU_LIB
+	#error "ILI9325_USE_WR_TIMER is implemented for libopencm3 only"
+#endif
+
+_Static_assert((int)PORT_CTRL == (int)ili9325_PORTC && WR_PIN == 7, "TIM8 CH2 is available on PC7 only");
+_Static_assert((CTRL_INVERSIONS & (1 << WR_PIN)) == 0, "Inverted WR is not supported by timer");
+
+/**
+ * Configures TIM8 for WR strobes (private)
+ */
+static void tim8_init(void)
+{
+	rcc_periph_clock_enable(RCC_TIM8);
+	rcc_periph_reset_pulse(RST_TIM8);
+	timer_set_prescaler(TIM8, 0);
+	timer_set_period(TIM8, ILI9325_WR_TIMER_HIGH + ILI9325_WR_TIMER_LOW - 1);
+	timer_set_oc_mode(TIM8, TIM_OC2, TIM_OCM_PWM1);
+	timer_set_oc_value(TIM8, TIM_OC2, ILI9325_WR_TIMER_HIGH);
+	timer_enable_oc_output(TIM8, TIM_OC2);
+	timer_enable_break_main_output(TIM8);
+	timer_one_shot_mode(TIM8);
+	// Software UG only reloads repetition counter, no interrupt
+	timer_update_on_overflow(TIM8);
+	timer_enable_irq(TIM8, TIM_DIER_UIE);
+	nvic_enable_irq(NVIC_TIM8_UP_TIM13_IRQ);
+	gpio_set_af(GPIOC, GPIO_AF3, 1 << WR_PIN);
+}
+
+/**
+ * Switches WR pin to TIM8 output (private)
+ */
+static void tim8_attach(void)
+{
+	gpio_mode_setup(GPIOC, GPIO_MODE_AF, GPIO_PUPD_NONE, 1 << WR_PIN);
+}
+
+/**
+ * Starts run of strobes (private)
+ * @strobes: 1..ILI9325_WR_TIMER_RUN_MAX
+ */
+static void tim8_start(uint16_t strobes)
+{
+	timer_set_repetition_counter(TIM8, strobes - 1);
+	timer_generate_event(TIM8, TIM_EGR_UG);
+	timer_enable_counter(TIM8);
+}
+
+/**
+ * Switches WR pin back to GPIO output (private)
+ */
+static void tim8_detach(void)
+{
+	gpio_mode_setup(GPIOC, GPIO_MODE_OUTPUT, GPIO_PUPD_NONE, 1 << WR_PIN);
+}
+
+/**
+ * TIM8 update interrupt handler, the run is done
+ */
+void tim8_up_tim13_isr(void)
+{
+	if (!timer_get_flag(TIM8, TIM_SR_UIF)) return;
+	timer_clear_flag(TIM8, TIM_SR_UIF);
+	ili9325_wr_timer_run_done();
+}
+
+/*Hardware driver*/
+const ili9325_wr_timer_driver ili9325_wr_timer_tim8 = {
+	.init = tim8_init,
+	.attach = tim8_attach,
+	.start = tim8_start,
+	.detach = tim8_detach
+};
+
+/*Driver in use*/
+const ili9325_wr_timer_driver *ili9325_wr_timer = &ili9325_wr_timer_tim8;
+#endif
@@ -8,6 +8,45 @@
 #include <libopencm3/stm32/spi.h>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/flash.h>
+#include <libopencm3/stm32/fsmc.h>
+#endif
+
+#if ILI9325_BUS == _BUS_FSMC
+/*
+ * FSMC pins are fixed by F407 silicon (AF12).
+ * Port D: D2, D3, NOE, NWE, D13, D14, D15, D0, D1. Port E: D4..D12.
+ */
+#define FSMC_PINS_D   ((1 << 0) | (1 << 1) | (1 << 4) | (1 << 5) | (1 << 8) | (1 << 9) \
+                       | (1 << 10) | (1 << 14) | (1 << 15))
+#define FSMC_PINS_E   (0xFF80)
+
+/*Address line used as RS: A16..A18 are PD11..PD13, A19..A22 are PE3..PE6*/
+#if ILI9325_FSMC_RS_LINE >= 16 && ILI9325_FSMC_RS_LINE <= 18
+	#define FSMC_RS_PORT  ili9325_PORTD
+	#define FSMC_RS_PIN   (ILI9325_FSMC_RS_LINE - 5)
+#elif ILI9325_FSMC_RS_LINE >= 19 && ILI9325_FSMC_RS_LINE <= 22
+	#define FSMC_RS_PORT  ili9325_PORTE
+	#define FSMC_RS_PIN   (ILI9325_FSMC_RS_LINE - 16)
+#else
+	#error "ILI9325_FSMC_RS_LINE must be in range A16..A22"
+#endif
+
+/*Chip select line of the sub-bank: NE1 is PD7, NE2..NE4 are PG9, PG10, PG12*/
+#if ILI9325_FSMC_BANK == 1
+	#define FSMC_NE_PORT  ili9325_PORTD
+	#define FSMC_NE_PIN   7
+#elif ILI9325_FSMC_BANK == 2
+	#define FSMC_NE_PORT  ili9325_PORTG
+	#define FSMC_NE_PIN   9
+#elif ILI9325_FSMC_BANK == 3
+	#define FSMC_NE_PORT  ili9325_PORTG
+	#define FSMC_NE_PIN   10
+#elif ILI9325_FSMC_BANK == 4
+	#define FSMC_NE_PORT  ili9325_PORTG
+	#define FSMC_NE_PIN   12
+#else
+	#error "ILI9325_FSMC_BANK must be in range 1..4"
+#endif
 #endif
 
 /**
@@ -242,6 +281,72 @@ void pins_tft_init(const ili9325_pin_group* pins)
     pins_group_set(*pins, PIN_SET);                
 }
 
+#if ILI9325_BUS == _BUS_FSMC
+/**
+ * Sets the pin group to FSMC alternate function
+ * @pins: group of pins to configure
+ */
+static void pins_fsmc_af(const ili9325_pin_group* pins)
+{
+	rcc_enable_group(pins);
+	gpio_set_output_options(ili9325_pin_port_to_gpio(pins->port),
+							GPIO_OTYPE_PP,
+							GPIO_OSPEED_100MHZ,
+							pins->pins);
+	gpio_set_af(ili9325_pin_port_to_gpio(pins->port), GPIO_AF12, pins->pins);
+	gpio_mode_setup(ili9325_pin_port_to_gpio(pins->port),
+					GPIO_MODE_AF,
+					GPIO_PUPD_NONE,
+					pins->pins);
+}
+#endif
+
+/**
+ * Configuration of FSMC NOR/SRAM bank for ILI9325 bus
+ *
+ * Sets data, NOE, NWE, NEx and RS address line pins to FSMC alternate function
+ * and programs 16-bit SRAM mode with ILI9325_FSMC_ADDSET and ILI9325_FSMC_DATAST
+ * timings from config.h. RESET pin is still driven from ili9325_ctrl_pins,
+ * so pins_tft_init(&ili9325_ctrl_pins) is required as well.
+ *
+ * Note: Does nothing unless ILI9325_BUS is _BUS_FSMC. If HAL defined in config.h
+ * you need to use Cube IDE for FSMC initialization.
+ */
+void fsmc_tft_init(void)
+{
+#if ILI9325_BUS == _BUS_FSMC
+#if MCU_LIB
+	/*HAL*/
+	/*(!!!)Use Cube IDE for FSMC pins and NOR/SRAM bank initialization*/
+#else
+	const ili9325_pin_group pins_d = {.port = ili9325_PORTD, .pins = FSMC_PINS_D};
+	const ili9325_pin_group pins_e = {.port = ili9325_PORTE, .pins = FSMC_PINS_E};
+	const ili9325_pin_group pin_rs = {.port = FSMC_RS_PORT, .pins = 1 << FSMC_RS_PIN};
+	const ili9325_pin_group pin_ne = {.port = FSMC_NE_PORT, .pins = 1 << FSMC_NE_PIN};
+
+	pins_fsmc_af(&pins_d);
+	pins_fsmc_af(&pins_e);
+	pins_fsmc_af(&pin_rs);
+	pins_fsmc_af(&pin_ne);
+
+	rcc_periph_clock_enable(RCC_FSMC);
+	// Extended mode A: BTR holds slow GRAM read timings, BWTR fast write ones.
+	// BWTR has the same layout as BTR
+	FSMC_BTR(ILI9325_FSMC_BANK - 1) = FSMC_BTR_ACCMODx(FSMC_BTx_ACCMOD_A)
+									| FSMC_BTR_DATASTx(ILI9325_FSMC_RD_DATAST)
+									| FSMC_BTR_ADDSETx(ILI9325_FSMC_RD_ADDSET);
+	FSMC_BWTR(ILI9325_FSMC_BANK - 1) = FSMC_BTR_ACCMODx(FSMC_BTx_ACCMOD_A)
+									| FSMC_BTR_DATASTx(ILI9325_FSMC_DATAST)
+									| FSMC_BTR_ADDSETx(ILI9325_FSMC_ADDSET);
+	// SRAM type (MTYP = 0), 16-bit width, writes enabled, extended mode, bank enabled.
+	// Bit 7 is reserved and must be kept at reset value
+	FSMC_BCR(ILI9325_FSMC_BANK - 1) = (FSMC_BCR(ILI9325_FSMC_BANK - 1) & (1 << 7))
+									| FSMC_BCR_EXTMOD | FSMC_BCR_WREN
+									| FSMC_BCR_MWID | FSMC_BCR_MBKEN;
+#endif
+#endif
+}
+
 /**
  * Initializing SPI MOSI, MISO, SCK, CS for xpt2046 touch chip
  * @cs: pointer to the CS pin init struct
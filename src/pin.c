@@ -230,14 +230,14 @@ void write_port_data(ili9325_pin_group pins, uint16_t data)
 const ili9325_pin_group ili9325_ctrl_pins = {
 		.port = PORT_CTRL,
 		.pins = (1 << RS_PIN) | (1 << WR_PIN) | (1 << CS_PIN) | (1 << RESET_PIN) | (1 << RD_PIN),
-		.inversions = 0
+		.inversions = CTRL_INVERSIONS
 };
 
 /*Screen data bus pins*/
 const ili9325_pin_group ili9325_data_pins = {
 		.port = PORT_DATA,
 		.pins = 0xFFFF, // all pins of this port
-		.inversions = 0
+		.inversions = DATA_INVERSIONS
 };
 
 /*Touch SPI pins*/
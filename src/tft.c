@@ -7,8 +7,10 @@
 
 #include "tft.h"
 #include "ili9325.h"
+#include "ili9325_async.h"
 #include "macro.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <libprintf/printf.h>
 // #include <stdio.h>
@@ -36,6 +38,30 @@ void tft_init(uint16_t width, uint16_t hight, uint16_t color)
 	tft_fill_screen(color);
 }
 
+/*Pixels of every font nibble in the font colors, most significant bit first*/
+static uint16_t glyph_lut[16][4];
+static uint16_t lut_color, lut_back_color;
+static bool lut_valid = false;
+
+/**
+ * Rebuilds the nibble table if the font colors changed (private)
+ *
+ * Note: font_color and font_back_color are globals, so the table is checked before
+ * every glyph rather than only in tft_set_font().
+ */
+static void glyph_lut_update(void)
+{
+	if (lut_valid && lut_color == font_color && lut_back_color == font_back_color) return;
+	for (uint8_t n = 0; n < 16; n++) {
+		for (uint8_t i = 0; i < 4; i++) {
+			glyph_lut[n][i] = (n & (0x08 >> i)) ? font_color : font_back_color;
+		}
+	}
+	lut_color = font_color;
+	lut_back_color = font_back_color;
+	lut_valid = true;
+}
+
 /**
  * Font settings
  * @type:  Font type.
@@ -46,6 +72,8 @@ void tft_set_font(uint8_t type,	uint16_t color, uint16_t back_color)
 {
 	font_color = color;
 	font_back_color = back_color;
+	glyph_lut_update();
+	font_prop = NULL;
 	switch(type) {
 		case COURIER_NEW_8_BOLD:	font_type = font8;
 				break;
@@ -59,16 +87,408 @@ void tft_set_font(uint8_t type,	uint16_t color, uint16_t back_color)
 				break;
 		case SEVEN_SEGMENT:         font_type = seven_seg_num_font;
 				break;
+		case UBUNTU_14_PROP:        font_prop = &font14_prop;
+				break;
 		default:font_type= font8_normal;
 		        break;
 	}
 
+	if (font_prop != NULL) {
+		font_type	= NULL;
+		font_width	= 0;		 // Widest symbol, for wrapping
+		for (uint16_t i = 0; i <= font_prop->last - font_prop->first; i++) {
+			font_width = max(font_width, font_prop->glyphs[i].advance);
+		}
+		font_height	= font_prop->height;
+		font_byte	= 0;
+		offset_char	= font_prop->first;
+		return;
+	}
 	font_width	= font_type[0];	 // Width in pixels
 	font_height	= font_type[1];	 // Height in pixels
 	font_byte	= font_type[2];	 // Amounts of bytes for one sumbol
 	offset_char	= font_type[3];	 // Offset to the beginning of the symbol table
 }
 
+/*Clip rectangles pushed by tft_push_clip(), each one is cut by the previous one*/
+static tft_rect clip_stack[TFT_CLIP_DEPTH];
+static uint8_t clip_depth = 0;
+
+/**
+ * Gets the area drawing is clipped to: the top clip rectangle cut by the screen (private)
+ * @c: clip area
+ * @return: false if nothing is visible
+ */
+static bool clip_get(tft_rect *c)
+{
+	c->x1 = 0;
+	c->y1 = 0;
+	c->x2 = disp_orient.width - 1;
+	c->y2 = disp_orient.hight - 1;
+	if (clip_depth != 0) {
+		const tft_rect *top = &clip_stack[clip_depth - 1];
+		c->x1 = top->x1;
+		c->y1 = top->y1;
+		c->x2 = min(c->x2, top->x2);
+		c->y2 = min(c->y2, top->y2);
+	}
+	return c->x1 <= c->x2 && c->y1 <= c->y2;
+}
+
+/**
+ * Cuts a rectangle by another one (private)
+ * @x1, @y1, @x2, @y2: corners, may be off the screen
+ * @c: cutting rectangle
+ * @r: common part
+ * @return: false if there is no common part
+ */
+static bool rect_cut(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const tft_rect *c, tft_rect *r)
+{
+	x1 = max(x1, (int32_t)c->x1);
+	y1 = max(y1, (int32_t)c->y1);
+	x2 = min(x2, (int32_t)c->x2);
+	y2 = min(y2, (int32_t)c->y2);
+	if (x1 > x2 || y1 > y2) return false;
+	r->x1 = x1;
+	r->y1 = y1;
+	r->x2 = x2;
+	r->y2 = y2;
+	return true;
+}
+
+/**
+ * Clips a rectangle to the clip area (private)
+ * @x1, @y1: top left corner, may be off the screen
+ * @x2, @y2: bottom right corner
+ * @r: visible part
+ * @return: false if nothing is visible
+ */
+static bool clip_rect(int32_t x1, int32_t y1, int32_t x2, int32_t y2, tft_rect *r)
+{
+	tft_rect c;
+	return clip_get(&c) && rect_cut(x1, y1, x2, y2, &c, r);
+}
+
+/**
+ * Fills the visible part of a rectangle as one frame (private)
+ * @return: false if nothing is visible
+ */
+static bool clip_fill(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color)
+{
+	tft_rect r;
+	if (!clip_rect(x1, y1, x2, y2, &r)) return false;
+	if (tft_set_frame(r.x1, r.y1, r.x2, r.y2)) return false;
+	tft_fill_pixels(color, (uint32_t)(r.x2 - r.x1 + 1) * (r.y2 - r.y1 + 1));
+	return true;
+}
+
+/**
+ * Restricts drawing to a rectangle inside the current clip area
+ * @rect: clip rectangle
+ * @return: TFT_EOK if success, TFT_EWRONGARG if rect is NULL or reversed or
+ *          TFT_EFULL if TFT_CLIP_DEPTH rectangles are pushed
+ *
+ * Note: primitives clip their spans, rows and image rows, pixels out of the area are
+ * not sent. tft_fill_screen() and the pixel functions are not clipped.
+ */
+tft_err tft_push_clip(const tft_rect *rect)
+{
+	if (rect == NULL || rect->x2 < rect->x1 || rect->y2 < rect->y1) return TFT_EWRONGARG;
+	if (clip_depth == TFT_CLIP_DEPTH) return TFT_EFULL;
+	tft_rect r = *rect;
+	if (clip_depth != 0) {
+		const tft_rect *top = &clip_stack[clip_depth - 1];
+		r.x1 = max(r.x1, top->x1);
+		r.y1 = max(r.y1, top->y1);
+		r.x2 = min(r.x2, top->x2);
+		r.y2 = min(r.y2, top->y2);
+	}
+	clip_stack[clip_depth++] = r;			// May be empty, then nothing is drawn
+	return TFT_EOK;
+}
+
+/**
+ * Restores the clip area before the last tft_push_clip()
+ * @return: TFT_EOK if success or TFT_EEMPTY if no rectangle is pushed
+ */
+tft_err tft_pop_clip(void)
+{
+	if (clip_depth == 0) return TFT_EEMPTY;
+	clip_depth--;
+	return TFT_EOK;
+}
+
+/**
+ * Gets the current clip area, the screen if no rectangle is pushed
+ * @rect: clip area
+ * @return: false if the area is empty
+ */
+bool tft_get_clip(tft_rect *rect)
+{
+	return clip_get(rect);
+}
+
+/**
+ * Fills a run of line pixels drawn with the square pen of width size (private)
+ * @xa, @ya: first pixel of the run
+ * @xb, @yb: last pixel of the run
+ * @width: pen size, the pen square is anchored at its top left corner
+ * @color: line color
+ *
+ * Note: the pen squares of the run form one rectangle, it is clipped and sent as
+ * a single frame.
+ */
+static void line_span(uint16_t xa, uint16_t ya, uint16_t xb, uint16_t yb, uint8_t width, uint16_t color)
+{
+	clip_fill(min(xa, xb), min(ya, yb), (int32_t)max(xa, xb) + width - 1,
+			  (int32_t)max(ya, yb) + width - 1, color);
+}
+
+/*Maximum amount of segments stroked in one pass (rectangle outline)*/
+#define STROKE_SEGS_MAX	4
+
+/*Stroke of one segment, convex: quad of the segment body plus optional round caps*/
+typedef struct {
+	float qx[4], qy[4];		// Body corners in drawing order
+	float cx[2], cy[2];		// Centers of round caps
+	bool round;
+} stroke_seg;
+
+/*Maximum amount of disjoint spans on one row*/
+#define ROW_SPANS_MAX	STROKE_SEGS_MAX
+
+/*Span of pixels xl..xr on rows from y0 to the current one*/
+typedef struct {
+	int16_t xl, xr;
+	uint16_t y0;
+} row_span;
+
+/*Spans of consecutive rows, equal spans of adjacent rows are merged into one frame*/
+typedef struct {
+	row_span pend[ROW_SPANS_MAX];
+	uint8_t n;
+	uint16_t color;
+	tft_rect clip;			// Clip area, rows out of it are not added
+} row_spans;
+
+static enum tft_line_cap line_cap = TFT_CAP_SQUARE;
+
+/**
+ * Builds the stroke of a segment for the pen of width size (private)
+ * @seg: stroke to build
+ * @x1, @y1: segment start, pen top left corner as for 1 pixel lines
+ * @x2, @y2: segment end
+ * @width: pen size
+ * @cap: cap style of both ends
+ */
+static void stroke_build(stroke_seg *seg, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
+		                 uint8_t width, enum tft_line_cap cap)
+{
+	float r = width * 0.5f;
+	// Axis runs through the pen centers
+	float ax = x1 + r, ay = y1 + r, bx = x2 + r, by = y2 + r;
+	float dx = bx - ax, dy = by - ay;
+	float len = sqrtf(dx * dx + dy * dy);
+	float ux = 1.0f, uy = 0.0f;				// Unit direction, any for a dot
+
+	if (len > 0.0f) {
+		ux = dx / len;
+		uy = dy / len;
+	} else if (cap == TFT_CAP_BUTT) {
+		cap = TFT_CAP_SQUARE;				// Dot is drawn as the pen
+	}
+	if (cap == TFT_CAP_SQUARE) {
+		ax -= ux * r; ay -= uy * r;
+		bx += ux * r; by += uy * r;
+	}
+	float nx = -uy * r, ny = ux * r;		// Half width normal
+
+	seg->qx[0] = ax + nx; seg->qy[0] = ay + ny;
+	seg->qx[1] = bx + nx; seg->qy[1] = by + ny;
+	seg->qx[2] = bx - nx; seg->qy[2] = by - ny;
+	seg->qx[3] = ax - nx; seg->qy[3] = ay - ny;
+	seg->cx[0] = ax; seg->cy[0] = ay;
+	seg->cx[1] = bx; seg->cy[1] = by;
+	seg->round = (cap == TFT_CAP_ROUND);
+}
+
+/**
+ * Finds the pixels of a stroke on a row (private)
+ * @seg: stroke
+ * @r: pen radius
+ * @yc: row center
+ * @xl: first covered pixel
+ * @xr: last covered pixel
+ * @return: true if the row crosses the stroke
+ *
+ * Note: stroke is convex, so it covers one interval of the row. Pixel is covered
+ * when its center is inside the stroke.
+ */
+static bool stroke_row(const stroke_seg *seg, float r, float yc, int16_t *xl, int16_t *xr)
+{
+	float lo = INFINITY, hi = -INFINITY;
+
+	for (uint8_t i = 0; i < 4; i++) {
+		uint8_t j = (i + 1) & 3;
+		float yi = seg->qy[i], yj = seg->qy[j];
+		if ((yc < yi && yc < yj) || (yc > yi && yc > yj)) continue;
+		if (yi == yj) {
+			lo = min(lo, min(seg->qx[i], seg->qx[j]));
+			hi = max(hi, max(seg->qx[i], seg->qx[j]));
+		} else {
+			float x = seg->qx[i] + (yc - yi) * (seg->qx[j] - seg->qx[i]) / (yj - yi);
+			lo = min(lo, x);
+			hi = max(hi, x);
+		}
+	}
+	if (seg->round) {
+		for (uint8_t i = 0; i < 2; i++) {
+			float d = yc - seg->cy[i];
+			if (d * d > r * r) continue;
+			float h = sqrtf(r * r - d * d);
+			lo = min(lo, seg->cx[i] - h);
+			hi = max(hi, seg->cx[i] + h);
+		}
+	}
+	if (lo > hi) return false;
+	*xl = (int16_t)ceilf(lo - 0.5f);
+	*xr = (int16_t)floorf(hi - 0.5f);
+	return *xl <= *xr;
+}
+
+/**
+ * Clips span of a row to the clip area (private)
+ * @rs: spans state
+ * @span: span to fill
+ * @xl: first pixel
+ * @xr: last pixel
+ * @return: true if something is left
+ */
+static bool row_span_clip(const row_spans *rs, row_span *span, int xl, int xr)
+{
+	xl = max(xl, (int)rs->clip.x1);
+	xr = min(xr, (int)rs->clip.x2);
+	if (xl > xr) return false;
+	span->xl = xl;
+	span->xr = xr;
+	return true;
+}
+
+/**
+ * Sends pending span as one frame (private)
+ */
+static void row_span_flush(const row_span *span, uint16_t y_end, uint16_t color)
+{
+	if (tft_set_frame(span->xl, span->y0, span->xr, y_end)) return;
+	tft_fill_pixels(color, (uint32_t)(span->xr - span->xl + 1) * (y_end - span->y0 + 1));
+}
+
+/**
+ * Adds spans of the next row. Spans equal to the previous row continue, others are
+ * sent (private)
+ * @rs: spans state, zero n before the first row
+ * @y: row, next to the one of the previous call
+ * @row: sorted disjoint spans of the row, clipped
+ * @n: amount of spans
+ */
+static void row_spans_add(row_spans *rs, uint16_t y, row_span *row, uint8_t n)
+{
+	for (uint8_t k = 0; k < n; k++) row[k].y0 = y;
+	for (uint8_t p = 0; p < rs->n; p++) {
+		bool cont = false;
+		for (uint8_t k = 0; k < n; k++) {
+			if (row[k].xl == rs->pend[p].xl && row[k].xr == rs->pend[p].xr) {
+				row[k].y0 = rs->pend[p].y0;
+				cont = true;
+				break;
+			}
+		}
+		if (!cont) row_span_flush(&rs->pend[p], y - 1, rs->color);
+	}
+	for (uint8_t k = 0; k < n; k++) rs->pend[k] = row[k];
+	rs->n = n;
+}
+
+/**
+ * Sends all pending spans (private)
+ * @rs: spans state
+ * @y_last: last added row
+ */
+static void row_spans_end(row_spans *rs, uint16_t y_last)
+{
+	for (uint8_t p = 0; p < rs->n; p++) row_span_flush(&rs->pend[p], y_last, rs->color);
+	rs->n = 0;
+}
+
+/**
+ * Fills union of strokes scanline by scanline, every covered pixel is written once (private)
+ * @seg: strokes
+ * @n: amount of strokes, up to STROKE_SEGS_MAX
+ * @width: pen size
+ * @color: line color
+ *
+ * Note: equal spans of adjacent rows are merged into one rectangle, so axis aligned
+ * strokes cost one frame each.
+ */
+static void stroke_fill(const stroke_seg *seg, uint8_t n, uint8_t width, uint16_t color)
+{
+	float r = width * 0.5f;
+	float top = INFINITY, bottom = -INFINITY;
+	row_spans rs = {.n = 0, .color = color};
+	row_span row[ROW_SPANS_MAX];
+
+	if (!clip_get(&rs.clip)) return;
+	for (uint8_t s = 0; s < n; s++) {
+		for (uint8_t i = 0; i < 4; i++) {
+			top = min(top, seg[s].qy[i]);
+			bottom = max(bottom, seg[s].qy[i]);
+		}
+		for (uint8_t i = 0; i < 2; i++) {
+			top = min(top, seg[s].cy[i] - r);
+			bottom = max(bottom, seg[s].cy[i] + r);
+		}
+	}
+	int y_first = max((int)floorf(top), (int)rs.clip.y1);
+	int y_last = min((int)ceilf(bottom), (int)rs.clip.y2);
+
+	for (int y = y_first; y <= y_last; y++) {
+		uint8_t n_row = 0;
+		// One interval per stroke, insertion sorted and merged
+		for (uint8_t s = 0; s < n; s++) {
+			int16_t xl, xr;
+			row_span span;
+			if (!stroke_row(&seg[s], r, y + 0.5f, &xl, &xr)) continue;
+			if (!row_span_clip(&rs, &span, xl, xr)) continue;
+			uint8_t k = n_row++;
+			while (k > 0 && row[k - 1].xl > span.xl) {
+				row[k] = row[k - 1];
+				k--;
+			}
+			row[k] = span;
+		}
+		uint8_t m = 0;
+		for (uint8_t k = 0; k < n_row; k++) {
+			if (m > 0 && row[k].xl <= row[m - 1].xr + 1) {
+				row[m - 1].xr = max(row[m - 1].xr, row[k].xr);
+			} else {
+				row[m++] = row[k];
+			}
+		}
+		row_spans_add(&rs, y, row, m);
+	}
+	if (y_first <= y_last) row_spans_end(&rs, y_last);
+}
+
+/**
+ * Sets cap style of lines wider than 1 pixel
+ * @cap: TFT_CAP_BUTT (ends at the end points), TFT_CAP_SQUARE (extended by half
+ *       width, default) or TFT_CAP_ROUND
+ */
+void tft_set_line_cap(enum tft_line_cap cap)
+{
+	line_cap = cap;
+}
+
 /**
  * Drawing the line(Bresenham's algorithm)
  * @x1:    line start coordinate x
@@ -77,31 +497,60 @@ void tft_set_font(uint8_t type,	uint16_t color, uint16_t back_color)
  * @y2:    line end coordinate y
  * @width: line width
  * @color: line color
+ *
+ * Note: pixels are grouped into runs along the major axis, each run is one frame
+ * and one burst instead of a frame per pixel. Wider lines are filled as a quad with
+ * the caps set by tft_set_line_cap(), each pixel is written once.
  */
 void tft_draw_line(uint16_t x1, uint16_t y1, uint16_t x2,uint16_t y2, uint8_t width, uint16_t color)
 {
+	if (width == 0) return;
+	if (width > 1) {
+		stroke_seg seg;
+		stroke_build(&seg, x1, y1, x2, y2, width, line_cap);
+		stroke_fill(&seg, 1, width, color);
+		return;
+	}
+	// Horizontal and vertical lines are a single run
+	if (y1 == y2 || x1 == x2) {
+		line_span(x1, y1, x2, y2, width, color);
+		return;
+	}
+
 	int deltaX = abs(x2 - x1);				// Finding the difference between x2 and x1 by module
 	int deltaY = abs(y2 - y1);				// Finding the difference between y2 and y1 by module
 	int signX = (x1 < x2) ? 1 : -1;			// Select the direction of drawing along the x axis
 	int signY = (y1 < y2) ? 1 : -1;			// Select the direction of drawing along the y axis
 	int error = deltaX - deltaY;			// Calculate the difference between the x and y offsets
+	bool x_major = deltaX >= deltaY;		// Runs go along the major axis
+	uint16_t run_x = x1, run_y = y1;		// First pixel of the current run
 
 	while(1)
 	{
-		tft_draw_point(x1, y1, width, color);
-		if(x1 == x2 && y1 == y2) return;	// End of line drawing when coordinates match
+		if(x1 == x2 && y1 == y2) break;		// End of line drawing when coordinates match
 		int error2 = error*2;
+		uint16_t next_x = x1, next_y = y1;
 
 		if(error2 > -deltaY) {				// Estimate the error
 			error -= deltaY;				// Error correction
-			x1 += signX;					// Move to the next coordinate along the x axis
+			next_x += signX;				// Move to the next coordinate along the x axis
 		}
 
 		if(error2 < deltaX) {				// Estimate the error
-			error += deltaX;				// Error correctionи
-			y1 += signY;					// Move to the next coordinate along the y axis
+			error += deltaX;				// Error correction
+			next_y += signY;				// Move to the next coordinate along the y axis
 		}
+
+		// Step along the minor axis closes the run
+		if (x_major ? (next_y != y1) : (next_x != x1)) {
+			line_span(run_x, run_y, x1, y1, width, color);
+			run_x = next_x;
+			run_y = next_y;
+		}
+		x1 = next_x;
+		y1 = next_y;
 	}
+	line_span(run_x, run_y, x2, y2, width, color);
 }
 
 /**
@@ -112,9 +561,20 @@ void tft_draw_line(uint16_t x1, uint16_t y1, uint16_t x2,uint16_t y2, uint8_t wi
  * @longY: y axis length
  * @width: line width
  * @color: line color
+ *
+ * Note: wide outline is filled as one shape with mitred corners.
  */
 void tft_draw_rectangle(uint16_t x, uint16_t y,	uint16_t longX, uint16_t longY, uint8_t width, uint16_t color)
 {
+	if (width > 1) {
+		stroke_seg seg[4];
+		stroke_build(&seg[0], x, y, x+longX, y, width, TFT_CAP_SQUARE);
+		stroke_build(&seg[1], x, y, x, y+longY, width, TFT_CAP_SQUARE);
+		stroke_build(&seg[2], x, y+longY, x+longX, y+longY, width, TFT_CAP_SQUARE);
+		stroke_build(&seg[3], x+longX, y, x+longX, y+longY, width, TFT_CAP_SQUARE);
+		stroke_fill(seg, 4, width, color);
+		return;
+	}
 	tft_draw_line(x, y, x+longX, y, width, color);
 	tft_draw_line(x, y, x, y+longY, width, color);
 	tft_draw_line(x, y+longY, x+longX, y+longY, width, color);
@@ -128,19 +588,41 @@ void tft_draw_rectangle(uint16_t x, uint16_t y,	uint16_t longX, uint16_t longY,
  * @longX: x axis length
  * @longY: y axis length
  * @color: fill color
- * @return: TFT_EOK if success or TFT_ERANGE if not
+ * @return: TFT_EOK if success or TFT_ERANGE if nothing is visible
  */
 tft_err tft_fill_rectangle(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY, uint16_t color)
  {
- 	uint32_t i = (uint32_t)longX*longY;	// Calculating the total number of pixels of the area
- 	if(tft_set_frame(x, y, x + longX -1 , y + longY - 1)) {
+ 	if(longX == 0 || longY == 0) return TFT_ERANGE;
+ 	if(!clip_fill(x, y, (int32_t)x + longX - 1, (int32_t)y + longY - 1, color)) {
  		return TFT_ERANGE;
  	}
- 	while(i--) tft_frame_draw_pixel(color);
  	return TFT_EOK;
  }
 
 
+/**
+ * Adds the row of a ring to spans (private)
+ * @rs: spans state
+ * @x0: center x
+ * @y: row
+ * @xo: outer half width of the row
+ * @xi: inner half width of the row, negative if the row is out of the hole
+ */
+static void ring_row(row_spans *rs, uint16_t x0, int y, int xo, int xi)
+{
+	row_span row[2];
+	uint8_t n = 0;
+
+	if (y < rs->clip.y1 || y > rs->clip.y2) return;
+	if (xi < 0) {
+		n += row_span_clip(rs, &row[n], x0 - xo, x0 + xo);
+	} else {
+		n += row_span_clip(rs, &row[n], x0 - xo, x0 - xi - 1);
+		n += row_span_clip(rs, &row[n], x0 + xi + 1, x0 + xo);
+	}
+	row_spans_add(rs, y, row, n);
+}
+
 /**
  * Drawing circle
  * @x0: start coordinate x
@@ -148,29 +630,94 @@ tft_err tft_fill_rectangle(uint16_t x, uint16_t y, uint16_t longX, uint16_t long
  * @radius: x axis length
  * @width: line width
  * @color: line color
+ *
+ * Note: drawn as a ring of width pixels inside the radius, row by row. Pixel (x, y) of the
+ * disc of radius R satisfies x*x + y*y <= R*R + R, row half widths are updated
+ * incrementally for one quadrant and mirrored. Each pixel is written once.
  */
 void tft_draw_circle (uint16_t x0, uint16_t y0, uint16_t radius, uint8_t width, uint16_t color)
 {
-	int x = -radius, y = 0, err = 2 - 2 * radius, e2;
-	do {
-
-		/*Arc of 1st quarter*/
-		tft_draw_point(x0 + x, y0 + y, width, color);
-		/*Arc of 2nd quarter*/
-		tft_draw_point(x0 + x, y0 - y, width, color);
-		/*Arc of 3rd quarter*/
-		tft_draw_point(x0 - x, y0 - y, width, color);
-		/*Arc of 4th quarter*/
-		tft_draw_point(x0 - x, y0 + y, width, color);
+	if (width == 0) return;
+	int ro = radius;
+	int ri = radius - width;					// Radius of the hole, none if not positive
+	int lim_o = ro * ro + ro;
+	int lim_i = ri * ri + ri;
+	int xo = 0, xi = -1;
+	row_spans rs = {.n = 0, .color = color};
+	int dy;
 
-		e2 = err;
-		if (e2 <= y) {
-			err += ++y * 2 + 1;
-			if (-x == y && e2 <= x) e2 = 0;
+	if (!clip_get(&rs.clip)) return;
+	// Top half, rows widen towards the center
+	for (dy = ro; dy >= 0; dy--) {
+		while ((xo + 1) * (xo + 1) + dy * dy <= lim_o) xo++;
+		if (ri > 0 && dy <= ri) {
+			while ((xi + 1) * (xi + 1) + dy * dy <= lim_i) xi++;
 		}
-		if (e2 > x) err += ++x * 2 + 1;
+		ring_row(&rs, x0, y0 - dy, xo, xi);
 	}
-	while (x <= 0);
+	// Bottom half, rows narrow
+	for (dy = 1; dy <= ro; dy++) {
+		while (xo * xo + dy * dy > lim_o) xo--;
+		if (xi >= 0 && dy > ri) {
+			xi = -1;
+		} else {
+			while (xi >= 0 && xi * xi + dy * dy > lim_i) xi--;
+		}
+		ring_row(&rs, x0, y0 + dy, xo, xi);
+	}
+	row_spans_end(&rs, min(y0 + ro, (int)rs.clip.y2));
+}
+
+/**
+ * Adds one span row of a rounded shape (private)
+ */
+static void round_row(row_spans *rs, int xl, int xr, int y)
+{
+	row_span span;
+	if (y < rs->clip.y1 || y > rs->clip.y2) return;
+	row_spans_add(rs, y, &span, row_span_clip(rs, &span, xl, xr));
+}
+
+/**
+ * Fills shape made of an ellipse split into quarters, one span per row (private)
+ * @xl: x of the left quarters center
+ * @xr: x of the right quarters center
+ * @yt: y of the top quarters center
+ * @yb: y of the bottom quarters center, rows between yt and yb are straight
+ * @a: horizontal radius
+ * @b: vertical radius
+ * @color: fill color
+ *
+ * Note: pixel (x, y) is inside when it is inside the ellipse with radii a + 1/2 and b + 1/2:
+ * 4*x*x*(2b+1)^2 + 4*y*y*(2a+1)^2 <= (2a+1)^2 * (2b+1)^2. For a circle it is
+ * x*x + y*y <= R*R + R as in tft_draw_circle(). Row half widths are updated
+ * incrementally (no square roots), every row is visited once.
+ */
+static void round_fill(int xl, int xr, int yt, int yb, uint16_t a, uint16_t b, uint16_t color)
+{
+	int64_t aa = (int64_t)(2 * a + 1) * (2 * a + 1);
+	int64_t bb = (int64_t)(2 * b + 1) * (2 * b + 1);
+	int64_t lim = aa * bb;
+	row_spans rs = {.n = 0, .color = color};
+	int x = 0, dy;
+
+	if (!clip_get(&rs.clip)) return;
+	aa *= 4;
+	bb *= 4;
+	// Top quarters, rows widen
+	for (dy = b; dy > 0; dy--) {
+		while (bb * (x + 1) * (x + 1) + aa * dy * dy <= lim) x++;
+		round_row(&rs, xl - x, xr + x, yt - dy);
+	}
+	// Straight part
+	while (bb * (x + 1) * (x + 1) <= lim) x++;
+	for (int y = yt; y <= yb; y++) round_row(&rs, xl - x, xr + x, y);
+	// Bottom quarters, rows narrow
+	for (dy = 1; dy <= b; dy++) {
+		while (bb * x * x + aa * dy * dy > lim) x--;
+		round_row(&rs, xl - x, xr + x, yb + dy);
+	}
+	row_spans_end(&rs, min(yb + b, (int)rs.clip.y2));
 }
 
 /**
@@ -182,18 +729,40 @@ void tft_draw_circle (uint16_t x0, uint16_t y0, uint16_t radius, uint8_t width,
  */
 void tft_fill_circle (uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color)
 {
-	int x = -radius, y = 0, err = 2 - 2 * radius, e2;
-	do {
-		tft_draw_line(x0 - x, y0 - y, x0 - x, y0 + y, 1, color);
-		tft_draw_line(x0 + x, y0 - y, x0 + x, y0 + y, 1, color);
-		e2 = err;
-		if (e2 <= y) {
-			err += ++y * 2 + 1;
-			if (-x == y && e2 <= x) e2 = 0;
-		}
-		if (e2 > x) err += ++x * 2 + 1;
-	}
-	while (x <= 0);
+	round_fill(x0, x0, y0, y0, radius, radius, color);
+}
+
+/**
+ * Filling the ellipse with color
+ * @x0: center coordinate x
+ * @y0: center coordinate y
+ * @rx: horizontal radius
+ * @ry: vertical radius
+ * @color: fill color
+ */
+void tft_fill_ellipse(uint16_t x0, uint16_t y0, uint16_t rx, uint16_t ry, uint16_t color)
+{
+	round_fill(x0, x0, y0, y0, rx, ry, color);
+}
+
+/**
+ * Filling the rectangle with rounded corners
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @longX: x axis length
+ * @longY: y axis length
+ * @radius: corner radius, limited to the half of the shorter side
+ * @color: fill color
+ * @return: TFT_EOK if success or TFT_EWRONGARG if the rectangle is empty
+ */
+tft_err tft_fill_round_rect(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY,
+		                    uint16_t radius, uint16_t color)
+{
+	if (longX == 0 || longY == 0) return TFT_EWRONGARG;
+	radius = min(radius, (uint16_t)(min(longX, longY) - 1) / 2);
+	round_fill(x + radius, x + longX - 1 - radius, y + radius, y + longY - 1 - radius,
+			   radius, radius, color);
+	return TFT_EOK;
 }
 
 /**
@@ -211,12 +780,67 @@ void tft_fill_circle (uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color)
 void tft_draw_triangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
 		               uint16_t x2, uint16_t y2, uint8_t width,  uint16_t color)
 {
+	// Wide outline is filled as one shape with round joins
+	if (width > 1) {
+		stroke_seg seg[3];
+		stroke_build(&seg[0], x0, y0, x1, y1, width, TFT_CAP_ROUND);
+		stroke_build(&seg[1], x1, y1, x2, y2, width, TFT_CAP_ROUND);
+		stroke_build(&seg[2], x2, y2, x0, y0, width, TFT_CAP_ROUND);
+		stroke_fill(seg, 3, width, color);
+		return;
+	}
 	tft_draw_line(x0, y0, x1, y1, width, color);
 	tft_draw_line(x1, y1, x2, y2, width, color);
 	tft_draw_line(x2, y2, x0, y0, width, color);
 }
 
 
+/*Integer edge of a triangle: x = x0 + dx * t / dy (truncated) on row t*/
+typedef struct {
+	int16_t x;			// x on the current row
+	int16_t step;		// whole part of x step per row, signed
+	int16_t sign;		// direction of x
+	int16_t frac;		// remainder of |dx| / dy per row
+	int16_t err;		// accumulated remainder
+	int16_t dy;
+} edge_step;
+
+/**
+ * Sets up edge at row t, the only division of the edge (private)
+ * @e: edge to set up
+ * @x0: x of the upper end
+ * @dx: x difference of the ends
+ * @dy: y difference of the ends, positive
+ * @t: row relative to the upper end
+ */
+static void edge_step_init(edge_step *e, int16_t x0, int16_t dx, int16_t dy, int16_t t)
+{
+	int32_t s = (int32_t)abs(dx) * t;
+	if (dy <= 0) {						// Horizontal edge is never stepped
+		dy = 1;
+		s = 0;
+	}
+	e->sign = (dx < 0) ? -1 : 1;
+	e->dy = dy;
+	e->x = x0 + e->sign * (int16_t)(s / dy);
+	e->err = s % dy;
+	e->step = e->sign * (abs(dx) / dy);
+	e->frac = abs(dx) % dy;
+}
+
+/**
+ * Moves edge to the next row without division (private)
+ */
+static inline void edge_step_next(edge_step *e)
+{
+	e->x += e->step;
+	e->err += e->frac;
+	if (e->err >= e->dy) {
+		e->err -= e->dy;
+		e->x += e->sign;
+	}
+}
+
 /**
  * Fill triangle.
  * @x0: coordinate x of the first point
@@ -261,7 +885,7 @@ tft_err tft_fill_triangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
 
 	int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
 			dx12 = x2 - x1, dy12 = y2 - y1;
-	int32_t sa = 0, sb = 0;
+	edge_step ea, eb;
 
 	// For upper part of triangle, find scanline crossings for segments
 	// 0-1 and 0-2.  If y1=y2 (flat-bottomed triangle), the scanline y1
@@ -274,11 +898,13 @@ tft_err tft_fill_triangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
 	else
 		last = y1 - 1; // Skip it
 
+	edge_step_init(&ea, x0, dx01, dy01, 0);
+	edge_step_init(&eb, x0, dx02, dy02, 0);
 	for (y = y0; y <= last; y++) {
-		a = x0 + sa / dy01;
-		b = x0 + sb / dy02;
-		sa += dx01;
-		sb += dx02;
+		a = ea.x;
+		b = eb.x;
+		edge_step_next(&ea);
+		edge_step_next(&eb);
 		if (a > b)
 			swap(a, b);
 		tft_draw_fast_h_lin(a, y, b - a + 1, color);
@@ -286,19 +912,138 @@ tft_err tft_fill_triangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
 
 	// For lower part of triangle, find scanline crossings for segments
 	// 0-2 and 1-2.  This loop is skipped if y1=y2.
-	sa = dx12 * (y - y1);
-	sb = dx02 * (y - y0);
+	edge_step_init(&ea, x1, dx12, dy12, y - y1);
+	edge_step_init(&eb, x0, dx02, dy02, y - y0);
 	for (; y <= y2; y++) {
-		a = x1 + sa / dy12;
-		b = x0 + sb / dy02;
-		sa += dx12;
-		sb += dx02;
+		a = ea.x;
+		b = eb.x;
+		edge_step_next(&ea);
+		edge_step_next(&eb);
 		if (a > b)
 			swap(a, b);
-		if(tft_draw_fast_h_lin(a, y, b - a + 1, color)) {;
+		tft_draw_fast_h_lin(a, y, b - a + 1, color);	// Rows out of the clip area are skipped
+	}
+	return TFT_EOK;
+}
+
+/*Polygon coordinates limit, keeps 16.16 fixed point edge steps in 32 bits*/
+#define POLYGON_COORD_MAX	16383
+
+/*Edge of a polygon in the edge table*/
+typedef struct {
+	int32_t x;			// x at the center of the current row, 16.16 fixed point
+	int32_t dx;			// x step per row, 16.16 fixed point
+	int16_t y_top;		// First row crossed by the edge
+	int16_t y_end;		// Row after the last one
+	int8_t dir;			// 1 if the edge goes down, -1 if up
+} poly_edge;
+
+static enum tft_fill_rule fill_rule = TFT_FILL_NON_ZERO;
+
+/**
+ * Sets the rule deciding which parts of self intersecting polygons are inside
+ * @rule: TFT_FILL_NON_ZERO (default) or TFT_FILL_EVEN_ODD
+ */
+void tft_set_fill_rule(enum tft_fill_rule rule)
+{
+	fill_rule = rule;
+}
+
+/**
+ * Fills pixels with centers between two crossings of a row (private)
+ * @y: row
+ * @xa: left crossing, 16.16 fixed point
+ * @xb: right crossing, 16.16 fixed point
+ * @color: fill color
+ */
+static void poly_span(int16_t y, int32_t xa, int32_t xb, uint16_t color)
+{
+	int32_t first = max((xa + 0x7FFF) >> 16, 0);
+	int32_t end = min((xb + 0x7FFF) >> 16, (int32_t)disp_orient.width);
+	if (end > first) tft_draw_fast_h_lin(first, y, end - first, color);
+}
+
+/**
+ * Fill polygon.
+ * @pts: vertices, the last one is connected to the first
+ * @n: amount of vertices, 3..TFT_POLYGON_POINTS_MAX
+ * @color: fill color
+ * @return: TFT_EOK if success, TFT_EWRONGARG if wrong arguments or TFT_ERANGE if
+ *          a coordinate is out of -16383..16383
+ *
+ * Note: pixel is filled when its center is inside, so polygons sharing an edge don't
+ * overlap. Concave and self intersecting polygons follow tft_set_fill_rule().
+ * Edges are stepped in 16.16 fixed point, there is no division per row.
+ */
+tft_err tft_fill_polygon(const tft_point *pts, uint16_t n, uint16_t color)
+{
+	if (pts == NULL || n < 3 || n > TFT_POLYGON_POINTS_MAX) return TFT_EWRONGARG;
+	poly_edge et[n];			// Edge table sorted by the first row
+	poly_edge *aet[n];			// Active edges sorted by x
+	uint16_t n_et = 0, n_aet = 0, next = 0;
+	int16_t y_last = -1;
+	tft_rect clip;
+
+	for (uint16_t i = 0; i < n; i++) {
+		if (abs(pts[i].x) > POLYGON_COORD_MAX || abs(pts[i].y) > POLYGON_COORD_MAX) {
 			return TFT_ERANGE;
 		}
 	}
+	if (!clip_get(&clip)) return TFT_EOK;
+	for (uint16_t i = 0; i < n; i++) {
+		tft_point p = pts[i], q = pts[(i + 1) % n];
+		poly_edge e;
+		e.dir = 1;
+		if (p.y == q.y) continue;			// Horizontal edges never cross row centers
+		if (p.y > q.y) {
+			tft_point t = p;
+			p = q;
+			q = t;
+			e.dir = -1;
+		}
+		// Rows with centers y + 0.5 in [p.y, q.y), clipped
+		e.y_top = max(p.y, (int16_t)clip.y1);
+		e.y_end = min(q.y, (int16_t)(clip.y2 + 1));
+		if (e.y_top >= e.y_end) continue;
+		e.dx = (int32_t)(q.x - p.x) * 65536 / (q.y - p.y);
+		e.x = (int32_t)p.x * 65536 + e.dx / 2 + e.dx * (e.y_top - p.y);
+		uint16_t k = n_et++;
+		while (k > 0 && et[k - 1].y_top > e.y_top) {
+			et[k] = et[k - 1];
+			k--;
+		}
+		et[k] = e;
+		y_last = max(y_last, (int16_t)(e.y_end - 1));
+	}
+
+	for (int16_t y = n_et ? et[0].y_top : 0; y <= y_last; y++) {
+		// Edges starting on the row join, finished ones leave
+		while (next < n_et && et[next].y_top == y) aet[n_aet++] = &et[next++];
+		uint16_t k = 0;
+		for (uint16_t i = 0; i < n_aet; i++) {
+			if (aet[i]->y_end > y) aet[k++] = aet[i];
+		}
+		n_aet = k;
+		// Insertion sort, the order barely changes from row to row
+		for (uint16_t i = 1; i < n_aet; i++) {
+			poly_edge *e = aet[i];
+			for (k = i; k > 0 && aet[k - 1]->x > e->x; k--) aet[k] = aet[k - 1];
+			aet[k] = e;
+		}
+		// Spans where the winding turns non zero
+		int16_t wind = 0;
+		int32_t x_in = 0;
+		for (uint16_t i = 0; i < n_aet; i++) {
+			int16_t prev = wind;
+			wind = (fill_rule == TFT_FILL_EVEN_ODD) ? (wind ^ 1) : (wind + aet[i]->dir);
+			if (prev == 0 && wind != 0) {
+				x_in = aet[i]->x;
+			} else if (prev != 0 && wind == 0) {
+				poly_span(y, x_in, aet[i]->x, color);
+			}
+		}
+		for (uint16_t i = 0; i < n_aet; i++) aet[i]->x += aet[i]->dx;
+	}
 	return TFT_EOK;
 }
 
@@ -308,27 +1053,11 @@ tft_err tft_fill_triangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
  * @y:      line start coordinate y
  * @length: line length
  * @color:  line color
- * @return: TFT_EOK if success or TFT_ERANGE if not
+ * @return: TFT_EOK if success or TFT_ERANGE if nothing is visible
  */
 tft_err tft_draw_fast_h_lin(int16_t x, int16_t y, int16_t length, uint16_t color)
 {
-	int16_t x2;
-	// Initial off-screen clipping
-	if ((length <= 0) || (y < 0) || (y >= disp_orient.hight) || (x >= disp_orient.width) ||
-		((x2 = (x + length - 1)) < 0)) return TFT_ERANGE;
-
-	if (x < 0) { // Clip left
-		length += x;
-		x = 0;
-	}
-	if (x2 >= disp_orient.width) { // Clip right
-		x2 = disp_orient.width - 1;
-		length = x2 - x + 1;
-	}
-
-	if(tft_set_frame(x, y, x2, y)) return TFT_ERANGE;
-	while(length--) tft_frame_draw_pixel(color);
-
+	if ((length <= 0) || !clip_fill(x, y, (int32_t)x + length - 1, y, color)) return TFT_ERANGE;
 	return TFT_EOK;
 }
 
@@ -338,26 +1067,56 @@ tft_err tft_draw_fast_h_lin(int16_t x, int16_t y, int16_t length, uint16_t color
  * @y:      line start coordinate y
  * @length: line length
  * @color:  line color
- * @return: TFT_EOK if success or TFT_ERANGE if not
+ * @return: TFT_EOK if success or TFT_ERANGE if nothing is visible
  */
 tft_err tft_draw_fast_v_lin(int16_t x, int16_t y, int16_t length, uint16_t color) {
 
-	int16_t y2;
-	// Initial off-screen clipping
-	if ((length <= 0) || (x < 0) || (x >= disp_orient.width) || (y >= disp_orient.hight) ||
-		((y2 = (y + length - 1)) <  0)) return TFT_ERANGE;
+	if ((length <= 0) || !clip_fill(x, y, x, (int32_t)y + length - 1, color)) return TFT_ERANGE;
+	return TFT_EOK;
+}
 
-	if (y < 0) { // Clip top
-		length += y;
-		y = 0;
+/**
+ * Drawing part of a picture, e.g. an icon of an atlas image
+ * @dst_x: screen coordinate x of the part, may be negative
+ * @dst_y: screen coordinate y of the part, may be negative
+ * @img: image data array of 16 bit words as for tft_pic_from_flash()
+ * @src: part of the image, NULL for the whole image
+ * @return: TFT_EOK if success, TFT_EWRONGARG if src is out of the image or
+ *          TFT_ERANGE if nothing is visible
+ *
+ * Note: the visible part is sent as one frame, a burst per row or a single burst if
+ * the rows are contiguous in the image. Hidden rows are not touched.
+ */
+tft_err tft_blit(int16_t dst_x, int16_t dst_y, const uint16_t *img, const tft_rect *src)
+{
+	uint16_t width = img[0];
+	uint16_t height = img[1];
+	tft_rect s = {0, 0, width - 1, height - 1};
+	tft_rect r;
+
+	if(width == 0 || height == 0) return TFT_ERANGE;
+	if(src != NULL) {
+		if(src->x1 > src->x2 || src->y1 > src->y2 || src->x2 >= width || src->y2 >= height) {
+			return TFT_EWRONGARG;
+		}
+		s = *src;
 	}
-	if (y2 >= disp_orient.hight) { // Clip bottom
-		y2 = disp_orient.hight - 1;
-		length = y2 - y + 1;
+	if(!clip_rect(dst_x, dst_y, (int32_t)dst_x + s.x2 - s.x1, (int32_t)dst_y + s.y2 - s.y1, &r)) {
+		return TFT_ERANGE;
 	}
-	if(tft_set_frame(x, y, x, y2)) return TFT_ERANGE;
-	while(length--) tft_frame_draw_pixel(color);
+	if(tft_set_frame(r.x1, r.y1, r.x2, r.y2)) return TFT_ERANGE;
 
+	// Pixel colors follow the 2 words of sizes
+	const uint16_t *px = &img[2] + (uint32_t)(s.y1 + r.y1 - dst_y) * width + s.x1 + (r.x1 - dst_x);
+	uint16_t vis_w = r.x2 - r.x1 + 1;
+	uint16_t vis_h = r.y2 - r.y1 + 1;
+	if(vis_w == width) {
+		tft_write_pixels(px, (uint32_t)vis_w * vis_h);	// Visible rows are contiguous
+	} else {
+		for(uint16_t j = 0; j < vis_h; j++, px += width) {
+			tft_write_pixels(px, vis_w);
+		}
+	}
 	return TFT_EOK;
 }
 
@@ -366,75 +1125,402 @@ tft_err tft_draw_fast_v_lin(int16_t x, int16_t y, int16_t length, uint16_t color
  * @x: start coordinate x
  * @y: start coordinate y
  * @img: image data array of 16 bit words
- * @return: TFT_EOK if success or TFT_ERANGE if not
+ * @return: TFT_EOK if success or TFT_ERANGE if nothing is visible
  */
 tft_err tft_pic_from_flash(uint16_t x, uint16_t y, const uint16_t* img)
+{
+	return tft_blit(x, y, img, NULL);
+}
+
+/**
+ * Fill rectangle with color without waiting for the transfer to finish.
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @longX: x axis length
+ * @longY: y axis length
+ * @color: fill color
+ * @done: callback called from interrupt when the rectangle is filled (may be NULL)
+ * @return: TFT_EOK if success or TFT_ERANGE if nothing is visible
+ * @context: use tft_wait_idle() to wait for completion, any other drawing waits for it too
+ */
+tft_err tft_fill_rect_async(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY, uint16_t color,
+		               void (*done)(void))
+{
+	tft_rect r;
+	if(longX == 0 || longY == 0) return TFT_ERANGE;
+	if(!clip_rect(x, y, (int32_t)x + longX - 1, (int32_t)y + longY - 1, &r)) return TFT_ERANGE;
+	if(tft_set_frame(r.x1, r.y1, r.x2, r.y2)) return TFT_ERANGE;
+	return tft_fill_pixels_async(color, (uint32_t)(r.x2 - r.x1 + 1) * (r.y2 - r.y1 + 1), done);
+}
+
+/**
+ * Drawing picture from the flash memory without waiting for the transfer to finish.
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @img: image data array of 16 bit words, must stay valid until the transfer is done
+ * @done: callback called from interrupt when the picture is drawn (may be NULL)
+ * @return: TFT_EOK if success or TFT_ERANGE if nothing is visible
+ * @context: use tft_wait_idle() to wait for completion, any other drawing waits for it too
+ *
+ * Note: a clipped picture is not one block of memory, it is drawn by
+ * tft_pic_from_flash() and done is called before return.
+ */
+tft_err tft_blit_async(uint16_t x, uint16_t y, const uint16_t* img, void (*done)(void))
 {
 	uint16_t width = img[0];
 	uint16_t height = img[1];
-	uint16_t color;
+	tft_rect r;
 
-	if(tft_set_frame(x, y, x+width - 1, y + height - 1)) {
-		return TFT_ERANGE;
+	if(width == 0 || height == 0) return TFT_ERANGE;
+	if(!clip_rect(x, y, (int32_t)x + width - 1, (int32_t)y + height - 1, &r)) return TFT_ERANGE;
+	if(r.x1 != x || r.y1 != y || r.x2 - r.x1 + 1 != width || r.y2 - r.y1 + 1 != height) {
+		tft_err err = tft_pic_from_flash(x, y, img);
+		if(done != NULL) done();
+		return err;
+	}
+	if(tft_set_frame(x, y, x + width - 1, y + height - 1)) return TFT_ERANGE;
+	return tft_write_pixels_async(&img[2], (uint32_t)width * height, done);
+}
+
+/**
+ * Gets a symbol of the current font
+ * @ascii: ASCII symbol, symbols missing in a proportional font give its first symbol
+ * @g: glyph bitmap and metrics
+ */
+void tft_font_get_glyph(uint16_t ascii, tft_glyph *g)
+{
+	if (font_prop != NULL) {
+		if (ascii < font_prop->first || ascii > font_prop->last) ascii = font_prop->first;
+		const prop_glyph *p = &font_prop->glyphs[ascii - font_prop->first];
+		g->bits = &font_prop->bitmap[p->offset];
+		g->width = p->width;
+		g->height = p->height;
+		g->x = p->x_ofs;
+		g->y = p->y_ofs;
+		g->advance = p->advance;
+		return;
+	}
+	if (ascii >= 192) ascii -= 64;
+	ascii -= offset_char;					          // Symbol code of the beginning of the symbol table
+	g->bits = &font_type[ascii * font_byte + 4];	  // Beginning of the symbol in the array
+	g->width = font_width;
+	g->height = font_height;
+	g->x = 0;
+	g->y = 0;
+	g->advance = font_width;
+}
+
+/**
+ * Gets the step from a symbol to the next one
+ * @ascii: ASCII symbol
+ * @next: next symbol or 0
+ * @return: advance of the symbol with kerning of the pair, font_width for fixed fonts
+ */
+uint16_t tft_char_advance(uint16_t ascii, uint16_t next)
+{
+	if (font_prop == NULL) return font_width;
+	if (ascii < font_prop->first || ascii > font_prop->last) ascii = font_prop->first;
+	int16_t adv = font_prop->glyphs[ascii - font_prop->first].advance;
+
+	// Binary search of the pair in the sorted table
+	uint16_t key = (ascii << 8) | (next & 0xFF);
+	int32_t lo = 0, hi = (int32_t)font_prop->kern_n - 1;
+	while (next != 0 && lo <= hi) {
+		int32_t mid = (lo + hi) / 2;
+		const prop_kern *k = &font_prop->kern[mid];
+		uint16_t mk = (k->left << 8) | k->right;
+		if (mk == key) {
+			adv += k->adjust;
+			break;
+		}
+		if (mk < key) lo = mid + 1;
+		else hi = mid - 1;
+	}
+	return max(adv, 0);
+}
+
+/*Foreground box of a glyph, relative to the glyph bitmap*/
+typedef struct {
+	uint8_t x, y, w, h;
+} glyph_box;
+
+/*Foreground of a glyph as boxes, decoded once by glyph_runs_get()*/
+typedef struct {
+	const void *font;					// Font of the entry, NULL if free
+	uint16_t ascii;
+	uint16_t runs;						// Runs of set bits in all rows
+	uint16_t pixels;					// Foreground pixels
+	uint8_t n;							// Boxes, TFT_TEXT_RUN_BOXES + 1 if they don't fit
+	glyph_box box[TFT_TEXT_RUN_BOXES];
+} glyph_runs;
+
+static bool text_transparent = false;
+static glyph_runs run_cache[TFT_TEXT_RUN_CACHE];
+static uint8_t run_next = 0;			// Entry replaced on the next miss
+
+/**
+ * Sets transparent text mode
+ * @transparent: true to draw only the set pixels of glyphs, the background stays
+ *
+ * Note: affects tft_print_char(), tft_print_str(), the number functions and
+ * tft_printf(). Each glyph is drawn either as boxes of its set pixels or by reading
+ * the cell back and writing it whole, whichever costs less bus time.
+ */
+void tft_set_text_transparent(bool transparent)
+{
+	text_transparent = transparent;
+}
+
+/**
+ * Checks a bit of a glyph (private)
+ */
+static inline bool glyph_bit(const tft_glyph *g, uint16_t i, uint16_t j)
+{
+	return g->bits[j * ((g->width + 7) / 8) + i / 8] & (0x80 >> (i % 8));
+}
+
+/**
+ * Gets the foreground boxes of a glyph of the current font (private)
+ * @g: glyph
+ * @ascii: ASCII symbol
+ * @return: cache entry
+ *
+ * Note: runs of equal position and length on adjacent rows make one box, so vertical
+ * strokes need one window. Misses replace entries in turn.
+ */
+static const glyph_runs *glyph_runs_get(const tft_glyph *g, uint16_t ascii)
+{
+	const void *font = (font_prop != NULL) ? (const void *)font_prop : (const void *)font_type;
+
+	for (uint8_t k = 0; k < TFT_TEXT_RUN_CACHE; k++) {
+		if (run_cache[k].font == font && run_cache[k].ascii == ascii) return &run_cache[k];
+	}
+	glyph_runs *e = &run_cache[run_next];
+	run_next = (run_next + 1) % TFT_TEXT_RUN_CACHE;
+	e->font = font;
+	e->ascii = ascii;
+	e->runs = 0;
+	e->pixels = 0;
+	e->n = 0;
+	for (uint8_t j = 0; j < g->height; j++) {
+		for (uint8_t i = 0; i < g->width; ) {
+			if (!glyph_bit(g, i, j)) {
+				i++;
+				continue;
+			}
+			uint8_t x = i;
+			while (i < g->width && glyph_bit(g, i, j)) i++;
+			e->runs++;
+			e->pixels += i - x;
+			if (e->n > TFT_TEXT_RUN_BOXES) continue;
+
+			uint8_t b = 0;
+			while (b < e->n && !(e->box[b].x == x && e->box[b].w == i - x &&
+			                     e->box[b].y + e->box[b].h == j)) b++;
+			if (b < e->n) {
+				e->box[b].h++;						// Run continues a box of the row above
+			} else if (e->n < TFT_TEXT_RUN_BOXES) {
+				e->box[e->n++] = (glyph_box){x, j, i - x, 1};
+			} else {
+				e->n = TFT_TEXT_RUN_BOXES + 1;
+			}
+		}
+	}
+	return e;
+}
+
+/**
+ * Fills a part of a rectangle in the font color (private)
+ * @x1, @y1, @x2, @y2: corners
+ * @c: visible area
+ */
+static void glyph_fill(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const tft_rect *c)
+{
+	tft_rect r;
+	if (!rect_cut(x1, y1, x2, y2, c, &r)) return;
+	if (tft_set_frame(r.x1, r.y1, r.x2, r.y2)) return;
+	tft_fill_pixels(font_color, (uint32_t)(r.x2 - r.x1 + 1) * (r.y2 - r.y1 + 1));
+}
+
+/**
+ * Draws the set pixels of a glyph by reading the visible part back (private)
+ * @r: visible part of the bitmap
+ * @g: glyph
+ * @ox, @oy: screen position of the bitmap
+ * @return: TFT_EOK if success or the error of tft_read_pixels()
+ */
+static tft_err glyph_cell(const tft_rect *r, const tft_glyph *g, int32_t ox, int32_t oy)
+{
+	uint16_t buf[TFT_TEXT_CHUNK];
+	uint16_t w = r->x2 - r->x1 + 1;
+	uint16_t rows = TFT_TEXT_CHUNK / w;
+
+	for (int32_t y = r->y1; y <= r->y2; y += rows) {
+		uint16_t nr = min((int32_t)rows, r->y2 - y + 1);
+		tft_err err = tft_read_pixels(r->x1, y, w, nr, buf);
+		if (err) return err;
+		for (uint16_t j = 0; j < nr; j++) {
+			for (uint16_t i = 0; i < w; i++) {
+				if (glyph_bit(g, r->x1 - ox + i, y - oy + j)) buf[j * w + i] = font_color;
+			}
+		}
+		if (tft_set_frame(r->x1, y, r->x2, y + nr - 1)) return TFT_ERANGE;
+		tft_write_pixels(buf, (uint32_t)w * nr);
+	}
+	return TFT_EOK;
+}
+
+/**
+ * Draws the set pixels of a glyph, the background stays (private)
+ * @cx, @cy: screen position of the symbol cell
+ * @ascii: ASCII symbol
+ * @g: glyph
+ * @cell: visible part of the cell
+ * @return: TFT_EOK
+ *
+ * Note: boxes cost a window each plus their pixels, the cell costs a read and a write
+ * window per chunk plus a read and a write of every pixel. Glyphs with more boxes
+ * than fit the cache are drawn by rows if the cell can't be read back.
+ */
+static tft_err glyph_transparent(int32_t cx, int32_t cy, uint16_t ascii, const tft_glyph *g,
+		                         const tft_rect *cell)
+{
+	int32_t ox = cx + g->x, oy = cy + g->y;
+	tft_rect r;
+
+	if (!rect_cut(ox, oy, ox + g->width - 1, oy + g->height - 1, cell, &r)) return TFT_EOK;
+	const glyph_runs *e = glyph_runs_get(g, ascii);
+	uint16_t w = r.x2 - r.x1 + 1, h = r.y2 - r.y1 + 1;
+
+	if (w <= TFT_TEXT_CHUNK) {
+		uint16_t chunk_rows = TFT_TEXT_CHUNK / w;
+		uint32_t cell_cost = (uint32_t)(h + chunk_rows - 1) / chunk_rows * 2 * TFT_TEXT_BOX_COST +
+		                     (uint32_t)w * h * (TFT_TEXT_READ_COST + 1);
+		uint32_t boxes = (e->n > TFT_TEXT_RUN_BOXES) ? e->runs : e->n;
+		if (cell_cost < boxes * TFT_TEXT_BOX_COST + e->pixels && !glyph_cell(&r, g, ox, oy)) {
+			return TFT_EOK;
+		}
 	}
 
-	for (uint16_t n = 2; n < width * height + 2; n++) {
-		color = img[n];								     // Read 2 bytes of pixel color from array
-		tft_frame_draw_pixel(color);
+	if (e->n <= TFT_TEXT_RUN_BOXES) {
+		for (uint8_t b = 0; b < e->n; b++) {
+			const glyph_box *bx = &e->box[b];
+			glyph_fill(ox + bx->x, oy + bx->y, ox + bx->x + bx->w - 1, oy + bx->y + bx->h - 1, &r);
+		}
+		return TFT_EOK;
+	}
+	for (uint16_t j = r.y1 - oy; j <= r.y2 - oy; j++) {
+		for (uint8_t i = 0; i < g->width; ) {
+			if (!glyph_bit(g, i, j)) {
+				i++;
+				continue;
+			}
+			uint8_t x1 = i;
+			while (i < g->width && glyph_bit(g, i, j)) i++;
+			glyph_fill(ox + x1, oy + j, ox + i - 1, oy + j, &r);
+		}
 	}
 	return TFT_EOK;
 }
 
 /**
- * Printing char
+ * Expands a glyph row into pixels of the font colors (private)
+ * @px: destination, bytes * 8 pixels
+ * @bits: glyph row
+ * @bytes: bytes of the row
+ */
+static inline void glyph_expand(uint16_t *px, const uint8_t *bits, uint8_t bytes)
+{
+	if (bytes == 1) {
+		// Glyphs up to 8 pixels wide: one byte per row
+		memcpy(px, glyph_lut[*bits >> 4], sizeof(glyph_lut[0]));
+		memcpy(px + 4, glyph_lut[*bits & 0x0F], sizeof(glyph_lut[0]));
+		return;
+	}
+	for (const uint8_t *end = bits + bytes; bits < end; px += 8, bits++) {
+		memcpy(px, glyph_lut[*bits >> 4], sizeof(glyph_lut[0]));
+		memcpy(px + 4, glyph_lut[*bits & 0x0F], sizeof(glyph_lut[0]));
+	}
+}
+
+/**
+ * Draws rows of a symbol cell into a frame of the cell width (private)
  * @x: start coordinate x
- * @y: start coordinate y
+ * @y: coordinate y of the first drawn row
  * @ascii: ASCII symbol
- * @return: true if success and false if not
- * @context: TFT_EOK if success or TFT_ERANGE if not
- * */
-tft_err tft_print_char(uint16_t x, uint16_t y, uint16_t ascii)
+ * @first: first cell row to draw
+ * @rows: amount of cell rows to draw
+ * @return: TFT_EOK if success or TFT_ERANGE if nothing is visible
+ *
+ * Note: only the visible part of the cell goes to the controller, rows of the cell
+ * outside the glyph bitmap are filled with the background color. In transparent
+ * text mode only the set pixels are drawn.
+ */
+static tft_err print_glyph_rows(uint16_t x, uint16_t y, uint16_t ascii, uint8_t first, uint8_t rows)
 {
-	uint16_t	line;
-	uint8_t		temp, pos = 0;
+	tft_glyph	g;
+	tft_rect	r;
 
-	if(x > disp_orient.width - font_width || y > disp_orient.hight - font_height) return TFT_ERANGE;
-	if(tft_set_frame(x, y, x + font_width-1, y + font_height - 1)) return TFT_ERANGE;
+	tft_font_get_glyph(ascii, &g);
+	if(!clip_rect(x, y, (int32_t)x + g.advance - 1, (int32_t)y + rows - 1, &r)) return TFT_ERANGE;
+	if(text_transparent) return glyph_transparent(x, (int32_t)y - first, ascii, &g, &r);
+	if(tft_set_frame(r.x1, r.y1, r.x2, r.y2)) return TFT_ERANGE;
+	glyph_lut_update();
 
-	if (ascii >= 192) ascii -= 64;
-	ascii -= offset_char;					          // Symbol code of the beginning of the symbol table
-	ascii = ascii * font_byte + 4;			          // Determining the address of the beginning of a symbol in an array
-	for(uint8_t j=0; j < font_height; j++) {
-		line = font_width;
-		while(line != 0) {
-			temp = font_type[ascii + (pos++)];
-			for(uint8_t i = 0; (i < 8) & (line != 0); i++, line--) {
-				if (temp & 0x80) {									// Highlighting the most significant bit
-					tft_frame_draw_pixel(font_color);           // Passing the pixel color of a char
-				}
-				else {
-					tft_frame_draw_pixel(font_back_color);      // Passing the pixel color of a background
-				}
-				temp <<= 1;										// Go to the next digit
-			}
+	uint8_t		bytes = (g.width + 7) / 8;			  // Each glyph row starts from a new byte
+	uint16_t	len = max((uint16_t)g.advance, (uint16_t)(g.x + bytes * 8));
+	uint16_t	row[len];							  // One cell row, sent as a single burst
+	const uint16_t *vis = row + (r.x1 - x);			  // Visible part of the row
+	uint16_t	n = r.x2 - r.x1 + 1;
+	uint32_t	blank = 0;							  // Background pixels not sent yet
+
+	// Cell columns around the bitmap stay in the background color
+	for (uint16_t i = 0; i < g.x; i++) row[i] = font_back_color;
+	for (uint16_t i = g.x + bytes * 8; i < len; i++) row[i] = font_back_color;
+
+	for(int32_t j = r.y1 - y + first - g.y; j <= r.y2 - y + first - g.y; j++) {
+		if (j < 0 || j >= g.height) {
+			blank += n;
+			continue;
+		}
+		if (blank) {
+			tft_fill_pixels(font_back_color, blank);
+			blank = 0;
 		}
+		glyph_expand(row + g.x, &g.bits[j * bytes], bytes);
+		tft_write_pixels(vis, n);
 	}
+	if (blank) tft_fill_pixels(font_back_color, blank);
 	return TFT_EOK;
 }
 
+/**
+ * Printing char
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @ascii: ASCII symbol
+ * @return: true if success and false if not
+ * @context: TFT_EOK if success or TFT_ERANGE if nothing is visible
+ * */
+tft_err tft_print_char(uint16_t x, uint16_t y, uint16_t ascii)
+{
+	return print_glyph_rows(x, y, ascii, 0, font_height);
+}
+
 /**
  * Printing the natural number
  * @x: coordinate x of first digit
  * @y: coordinate y of first digit
  * @num: number to print
  * @len: Places amount for digit, if len > num length the space will be replaced by ' '
- * @return: TFT_EOK if success or TFT_ERANGE if not
+ * @return: TFT_EOK if success or TFT_ERANGE if a digit is not visible
  * @context: Set the font by tft_set_font() before using
  */
 tft_err tft_print_num(	uint16_t x, uint16_t y, uint32_t num, uint8_t len)
 {
 	uint8_t t, temp;
 	uint8_t enshow = 0;
+	tft_err err = TFT_EOK;
 
 	for(t = 0; t < len; t++) {
 		temp = (num / (uint32_t)pow(10, len - t - 1)) % 10;
@@ -442,9 +1528,9 @@ tft_err tft_print_num(	uint16_t x, uint16_t y, uint32_t num, uint8_t len)
 			if(temp == 0) {
 				/*Printing a space if there is no number*/
 				if(tft_print_char(x, y, ' ')) {
-					return TFT_ERANGE;
+					err = TFT_ERANGE;			// Clipped digits don't stop the rest
 				}
-				x += font_width;				// Step to next
+				x += tft_char_advance(' ', 0);	// Step to next
 				continue;
 			}
 			else {
@@ -452,11 +1538,11 @@ tft_err tft_print_num(	uint16_t x, uint16_t y, uint32_t num, uint8_t len)
 			}
 		}
 		if(tft_print_char(x, y, temp + '0')) {
-			return TFT_ERANGE;
+			err = TFT_ERANGE;
 		}
-		x += font_width;						// Step to next
+		x += tft_char_advance(temp + '0', 0);	// Step to next
 	}
-	return TFT_EOK;
+	return err;
 }
 
 /**
@@ -465,20 +1551,21 @@ tft_err tft_print_num(	uint16_t x, uint16_t y, uint32_t num, uint8_t len)
  * @y: coordinate y of first digit
  * @num: number to print
  * @len: Places amount for digit, if len > num length the space will be replaced by 0
- * @return: TFT_EOK if success or TFT_ERANGE if not
+ * @return: TFT_EOK if success or TFT_ERANGE if a digit is not visible
  * @context: Set the font by tft_set_font() before using
  */
 tft_err tft_print_num0(uint16_t x, uint16_t y, uint32_t num, uint8_t len)
 {
 	uint8_t t, temp;
+	tft_err err = TFT_EOK;
 	for(t = 0; t < len; t++) {
 		temp = (num / (uint32_t)pow(10, len - t - 1)) % 10;
 		if(tft_print_char(x, y, temp + '0')) {
-			return TFT_ERANGE;
+			err = TFT_ERANGE;
 		}
-		x += font_width;
+		x += tft_char_advance(temp + '0', 0);
 	}
-	return TFT_EOK;
+	return err;
 }
 
 /**
@@ -487,46 +1574,122 @@ tft_err tft_print_num0(uint16_t x, uint16_t y, uint32_t num, uint8_t len)
  * @y: coordinate y of first symbol
  * @str: string to print
  * 
- * @return:TFT_EOK if success or TFT_ERANGE if not
+ * @return:TFT_EOK if success or TFT_ERANGE if a symbol is not visible
  */
 tft_err tft_print_str(uint16_t x, uint16_t y, const char *str)
 {
+	tft_err err = TFT_EOK;
 	while(*str != 0) {
-		if(x > disp_orient.width - font_width){
+		if(x + tft_char_advance(*str, 0) > disp_orient.width){
 			y += font_height; x = 0;
 		}
 		if(y > disp_orient.hight - font_height) {
 			y = 0; x = 0;
 		}
 		if(tft_print_char(x, y, *str)) {
-			return TFT_ERANGE;
+			err = TFT_ERANGE;					// Clipped symbols don't stop the rest
 		}
-		x += font_width;
+		x += tft_char_advance(*str, str[1]);	// Kerning with the next symbol
 		str++;
 	}
-	return TFT_EOK;
+	return err;
 }
 
 /**
  * Drawing the square dot with size and color
  * @w: Width coordinate
  * @h: Height coordinate
- * @size: Point side size (limited by size * size <65535)
+ * @size: Point side size
  * @color: Dot color
  * 
- * @return:TFT_EOK if success or TFT_ERANGE if not
+ * @return:TFT_EOK if success or TFT_ERANGE if nothing is visible
  */
 tft_err tft_draw_point(uint16_t w, uint16_t h, uint8_t size, uint16_t color)
 {
-	if (w + size >= disp_orient.width
-		|| h + size >= disp_orient.hight) return TFT_ERANGE;
-	uint16_t i = (uint16_t)size*size;
-	if(i >= 65535) return TFT_ERANGE;
-	if(tft_set_frame(w, h, w+size-1, h+size-1)) return TFT_ERANGE;
-	while(i--)	tft_frame_draw_pixel(color);
+	if (size == 0 || !clip_fill(w, h, (int32_t)w + size - 1, (int32_t)h + size - 1, color)) {
+		return TFT_ERANGE;
+	}
 	return TFT_EOK;
 }
 
+/*Hardware scrolling console state of tft_printf()*/
+static bool console_scroll = false;
+static uint16_t console_rot = 0;    // Rotation the scrolling was enabled for
+static uint16_t scroll_lines = 0;   // GRAM line shown on the top of the screen
+
+/**
+ * Fills rows of the console, wrapping at the end of GRAM (private)
+ * @y: first row in screen coordinates
+ * @rows: amount of rows
+ * @color: fill color
+ */
+static void console_fill_rows(uint16_t y, uint16_t rows, uint16_t color)
+{
+	uint16_t gy = (y + scroll_lines) % disp_orient.hight;
+	uint16_t first = min(rows, disp_orient.hight - gy);
+	tft_fill_rectangle(0, gy, disp_orient.width, first, color);
+	if (rows > first) tft_fill_rectangle(0, 0, disp_orient.width, rows - first, color);
+}
+
+/**
+ * Prints char of the console, glyph crossing the end of GRAM is split (private)
+ * @x: coordinate x
+ * @y: coordinate y in screen coordinates
+ * @ascii: ASCII symbol
+ */
+static void console_print_char(uint16_t x, uint16_t y, uint16_t ascii)
+{
+	if(x > disp_orient.width - font_width || y > disp_orient.hight - font_height) return;
+	uint16_t gy = (y + scroll_lines) % disp_orient.hight;
+	uint8_t first = min(font_height, disp_orient.hight - gy);
+	print_glyph_rows(x, gy, ascii, 0, first);
+	if (first < font_height) print_glyph_rows(x, 0, ascii, first, font_height - first);
+}
+
+/**
+ * Moves tft_printf() cursor to the next line. In scrolling mode at the bottom of the
+ * screen the band leaving the top is cleared and scrolled in as the new last line (private)
+ */
+static void console_new_line(void)
+{
+	cursor_x = 0;
+	cursor_y += font_height;
+	if (!console_scroll || cursor_y + font_height <= disp_orient.hight) return;
+
+	uint16_t shift = cursor_y + font_height - disp_orient.hight;
+	cursor_y = disp_orient.hight - font_height;
+	scroll_lines = (scroll_lines + shift) % disp_orient.hight;
+	console_fill_rows(cursor_y, font_height, font_back_color);
+	tft_set_scroll(scroll_lines);
+}
+
+/**
+ * Turns hardware scrolling of tft_printf() output on or off.
+ * With scrolling a new line at the bottom scrolls the screen up by one line, only the
+ * new line is sent to the controller.
+ * @enable: true to scroll, false to wrap to the top (default)
+ * @return: TFT_EOK if success or TFT_EWRONGARG if the controller can't scroll in
+ *          current orientation (album), printf keeps wrapping then
+ *
+ * Note: resets the cursor. While scrolled, other drawing functions use GRAM
+ * coordinates, so tft_printf() should own the screen. Rotation turns scrolling off.
+ */
+tft_err tft_set_console_scroll(bool enable)
+{
+	tft_err err = TFT_EOK;
+	// Gate lines, which the controller scrolls, run along y only in portrait
+	if (enable && disp_orient.flag != PORTRATE) {
+		enable = false;
+		err = TFT_EWRONGARG;
+	}
+	console_scroll = enable;
+	console_rot = disp_orient.current_rot;
+	scroll_lines = 0;
+	tft_set_scroll(0);
+	tft_set_cursor(0, 0);
+	return err;
+}
+
 /**
  * Sets the cursor coordinates for tft_printf()
  * @x: x-coordinate.
@@ -558,26 +1721,28 @@ void tft_printf(const char *fmt, ...)
 	width = font_width;
 	p = buf;
 
+	// Rotation has reset the scroll registers
+	if (console_scroll && console_rot != disp_orient.current_rot) tft_set_console_scroll(false);
+
 	while (*p) {
 		if (*p == '\n') {
-			cursor_y += height;
-			cursor_x = 0;
+			console_new_line();
 		} else if (*p == '\r') {
 			cursor_x = 0;
 		} else if (*p == '\t') {
 			cursor_x += width * 4;
 		} else {
-			if (cursor_y >= (tft_hight - height)) {
-				cursor_y = 0;
+			if (console_scroll) {
+				console_print_char(cursor_x, cursor_y, *p);
+			} else {
+				if (cursor_y >= (tft_hight - height)) {
+					cursor_y = 0;
+				}
+				tft_print_char(cursor_x, cursor_y, *p);
 			}
-			tft_print_char(cursor_x, cursor_y, *p);
-			cursor_x += width;
-			if (!disp_orient.flag && (cursor_x > (tft_width - width))) {
-				cursor_y += height;
-				cursor_x = 0;
-			} else if(disp_orient.flag && (cursor_x > (tft_hight - width))) {
-				cursor_y += height;
-				cursor_x = 0;
+			cursor_x += tft_char_advance(*p, p[1]);
+			if (cursor_x > (disp_orient.width - width)) {
+				console_new_line();
 			}
 		}
 		p++;
@@ -644,13 +1809,54 @@ void tft_colors_test(void) {
 	}
 }
 
+/**
+ * Saves the current pixel functions
+ * @ops: storage for the functions
+ */
+void tft_get_pixel_ops(tft_pixel_ops *ops)
+{
+	ops->set_frame = tft_set_frame;
+	ops->fill_screen = tft_fill_screen;
+	ops->frame_draw_pixel = tft_frame_draw_pixel;
+	ops->write_pixels = tft_write_pixels;
+	ops->fill_pixels = tft_fill_pixels;
+	ops->read_pixels = tft_read_pixels;
+	ops->fill_pixels_async = tft_fill_pixels_async;
+	ops->write_pixels_async = tft_write_pixels_async;
+	ops->wait_idle = tft_wait_idle;
+}
+
+/**
+ * Redirects drawing of all tft functions
+ * @ops: pixel functions to use, e.g. saved by tft_get_pixel_ops()
+ */
+void tft_set_pixel_ops(const tft_pixel_ops *ops)
+{
+	tft_set_frame = ops->set_frame;
+	tft_fill_screen = ops->fill_screen;
+	tft_frame_draw_pixel = ops->frame_draw_pixel;
+	tft_write_pixels = ops->write_pixels;
+	tft_fill_pixels = ops->fill_pixels;
+	tft_read_pixels = ops->read_pixels;
+	tft_fill_pixels_async = ops->fill_pixels_async;
+	tft_write_pixels_async = ops->write_pixels_async;
+	tft_wait_idle = ops->wait_idle;
+}
+
 uint16_t cursor_x = 0;
 uint16_t cursor_y = 0;
 
 tft_err (*tft_set_frame)(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2) = ili9325_set_frame;
 void (*tft_frame_draw_pixel)(uint16_t color) = ili9325_frame_draw_pixel;
+void (*tft_write_pixels)(const uint16_t *src, uint32_t n) = ili9325_write_pixels;
+void (*tft_fill_pixels)(uint16_t color, uint32_t n) = ili9325_fill_pixels;
+tft_err (*tft_read_pixels)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst) = ili9325_read_pixels;
+tft_err (*tft_fill_pixels_async)(uint16_t color, uint32_t n, void (*done)(void)) = ili9325_fill_pixels_async;
+tft_err (*tft_write_pixels_async)(const uint16_t *src, uint32_t n, void (*done)(void)) = ili9325_write_pixels_async;
+void (*tft_wait_idle)(void) = ili9325_wait_idle;
 void (*tft_fill_screen)(uint16_t color) = ili9325_fill_screen;
 tft_err (*tft_rotate_screen)(uint16_t rot_degrees)= ili9325_rotate_screen;
+tft_err (*tft_set_scroll)(uint16_t lines) = ili9325_set_scroll;
 void (*tft_reset)(void) = ili9325_screen_reset;
 
 
@@ -0,0 +1,222 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "tft_band.h"
+#include "ili9325.h"
+#include "macro.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ *                                     BAND RENDERER
+ * While a band is drawn tft_set_frame() only remembers the frame and the pixel functions
+ * walk it like the controller's address counter does, storing pixels that fall into the
+ * band and skipping the rest. So every primitive rasterizes exactly as in direct mode.
+ */
+
+#define TFT_BAND_PIXELS	((uint32_t)TFT_BAND_WIDTH * TFT_BAND_HEIGHT)
+
+/*Strip buffer*/
+static uint16_t band_buf[TFT_BAND_PIXELS] TFT_BAND_ATTR;
+
+/*Current band: rows y0..y0+rows-1 of width pixels*/
+static struct {
+	uint16_t y0;
+	uint16_t rows;
+	uint16_t width;
+	bool active;
+} band;
+
+/*Current frame and position in it*/
+static struct {
+	uint16_t x1, y1, x2, y2;
+	uint16_t x, y;
+} frame;
+
+/*Controller functions saved while the band is drawn*/
+static tft_pixel_ops panel;
+
+/**
+ * Remembers the frame, same checks as the controller (private)
+ */
+static tft_err band_set_frame(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2)
+{
+	if ((w1 >= disp_orient.width)||(h1 >= disp_orient.hight)
+	    ||(w2 >= disp_orient.width)||(h2 >= disp_orient.hight)){
+		return TFT_ERANGE;
+	}
+	frame.x1 = frame.x = w1;
+	frame.y1 = frame.y = h1;
+	frame.x2 = w2;
+	frame.y2 = h2;
+	return TFT_EOK;
+}
+
+/**
+ * Walks n pixels of the frame, pixels in the band are filled with color or copied
+ * from src (private)
+ * @src: pixels to copy or NULL to fill
+ * @color: fill color
+ * @n: amount of pixels
+ */
+static void band_walk(const uint16_t *src, uint16_t color, uint32_t n)
+{
+	while (n != 0) {
+		uint32_t k = min(n, (uint32_t)(frame.x2 - frame.x + 1));
+		uint16_t row = frame.y - band.y0;	// Wraps to a big value above the band
+
+		if (row < band.rows) {
+			uint16_t *dst = &band_buf[(uint32_t)row * band.width + frame.x];
+			if (src != NULL) {
+				memcpy(dst, src, k * sizeof(uint16_t));
+			} else {
+				for (uint32_t i = 0; i < k; i++) dst[i] = color;
+			}
+		}
+		if (src != NULL) src += k;
+		n -= k;
+		frame.x += k;
+		// End of the frame row, the frame wraps as GRAM address counter does
+		if (frame.x > frame.x2) {
+			frame.x = frame.x1;
+			frame.y = (frame.y == frame.y2) ? frame.y1 : frame.y + 1;
+		}
+	}
+}
+
+static void band_fill_pixels(uint16_t color, uint32_t n)
+{
+	band_walk(NULL, color, n);
+}
+
+static void band_write_pixels(const uint16_t *src, uint32_t n)
+{
+	band_walk(src, 0, n);
+}
+
+static void band_frame_draw_pixel(uint16_t color)
+{
+	band_walk(NULL, color, 1);
+}
+
+static void band_fill_screen(uint16_t color)
+{
+	uint32_t n = (uint32_t)band.width * band.rows;
+	for (uint32_t i = 0; i < n; i++) band_buf[i] = color;
+}
+
+static tft_err band_fill_pixels_async(uint16_t color, uint32_t n, void (*done)(void))
+{
+	if (n == 0) return TFT_EWRONGARG;
+	band_walk(NULL, color, n);
+	if (done != NULL) done();
+	return TFT_EOK;
+}
+
+static tft_err band_write_pixels_async(const uint16_t *src, uint32_t n, void (*done)(void))
+{
+	if (src == NULL || n == 0) return TFT_EWRONGARG;
+	band_walk(src, 0, n);
+	if (done != NULL) done();
+	return TFT_EOK;
+}
+
+static void band_wait_idle(void)
+{
+}
+
+/**
+ * Reads pixels back from the strip (private)
+ *
+ * Note: only rows inside the band are read, the other rows of dst are left as they are.
+ * They are not stored by this band anyway.
+ */
+static tft_err band_read_pixels(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst)
+{
+	if (dst == NULL || w == 0 || h == 0) return TFT_EWRONGARG;
+	if ((uint32_t)x + w > disp_orient.width || (uint32_t)y + h > disp_orient.hight) {
+		return TFT_ERANGE;
+	}
+	for (uint16_t j = 0; j < h; j++, dst += w) {
+		uint16_t row = y + j - band.y0;
+		if (row < band.rows) {
+			memcpy(dst, &band_buf[(uint32_t)row * band.width + x], w * sizeof(uint16_t));
+		}
+	}
+	return TFT_EOK;
+}
+
+/*Pixel functions drawing into the strip*/
+static const tft_pixel_ops band_ops = {
+	.set_frame = band_set_frame,
+	.fill_screen = band_fill_screen,
+	.frame_draw_pixel = band_frame_draw_pixel,
+	.write_pixels = band_write_pixels,
+	.fill_pixels = band_fill_pixels,
+	.read_pixels = band_read_pixels,
+	.fill_pixels_async = band_fill_pixels_async,
+	.write_pixels_async = band_write_pixels_async,
+	.wait_idle = band_wait_idle
+};
+
+/**
+ * Renders a frame band by band
+ * @draw: callback drawing the whole frame with tft functions, called once per band
+ * @ctx: passed to the callback
+ * @return: TFT_EOK if success, TFT_EWRONGARG if draw is NULL or called from the draw
+ *          callback, TFT_EFULL if the strip can't hold one row of the screen or the clip
+ *          stack is full
+ *
+ * Note: pixels not drawn by the callback are undefined unless TFT_BAND_PRELOAD is set,
+ * so the callback usually starts with tft_fill_screen(). Each pass is clipped to its
+ * band, primitives clip their spans and skip rows out of it. The callback may skip
+ * whole primitives which miss the band with tft_band_visible().
+ */
+tft_err tft_band_render(tft_band_draw_cb draw, void *ctx)
+{
+	if (draw == NULL || band.active) return TFT_EWRONGARG;
+	uint16_t width = disp_orient.width;
+	uint16_t rows = TFT_BAND_PIXELS / width;
+	if (rows == 0) return TFT_EFULL;
+
+	band.active = true;
+	band.width = width;
+	tft_get_pixel_ops(&panel);
+	for (uint16_t y0 = 0; y0 < disp_orient.hight; y0 += rows) {
+		band.y0 = y0;
+		band.rows = min(rows, (uint16_t)(disp_orient.hight - y0));
+#if TFT_BAND_PRELOAD
+		tft_read_pixels(0, y0, width, band.rows, band_buf);
+#endif
+		if (tft_push_clip(&(tft_rect){0, y0, width - 1, y0 + band.rows - 1})) {
+			band.active = false;
+			return TFT_EFULL;
+		}
+		tft_set_pixel_ops(&band_ops);
+		draw(ctx);
+		tft_set_pixel_ops(&panel);
+		tft_pop_clip();
+		// Whole band in one frame and one burst
+		tft_set_frame(0, y0, width - 1, y0 + band.rows - 1);
+		tft_write_pixels(band_buf, (uint32_t)width * band.rows);
+	}
+	band.active = false;
+	return TFT_EOK;
+}
+
+/**
+ * Checks whether rows intersect the band being drawn
+ * @y: first row
+ * @h: amount of rows
+ * @return: true if the rows are in the band or no band is being drawn
+ * @context: for draw callbacks of tft_band_render() to skip work
+ */
+bool tft_band_visible(uint16_t y, uint16_t h)
+{
+	if (!band.active) return true;
+	return (uint32_t)y < (uint32_t)band.y0 + band.rows && (uint32_t)y + h > band.y0;
+}
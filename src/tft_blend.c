@@ -0,0 +1,460 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "tft_blend.h"
+#include "ili9325.h"
+#include "macro.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <math.h>
+
+/**
+ *                                      ALPHA BLENDING
+ * Every channel is blended as (fg * a + bg * (32 - a)) >> 5 with a = 0..32.
+ * A pixel is spread to 32 bits by tft_rgb_spread(), the gaps between channels hold
+ * the products, so one multiply blends all three channels. Constant
+ * foreground and alpha are multiplied once per call.
+ */
+
+/*Source of blended pixels (private)*/
+typedef struct {
+	const uint16_t *pixels;		// Image pixels or NULL for the color
+	const uint8_t *mask;		// Alpha mask or NULL
+	enum tft_alpha_fmt fmt;
+	uint16_t width;				// Source width in pixels
+	uint16_t color;
+	uint16_t alpha;				// Opacity, 0..32
+} blend_src;
+
+/**
+ * Converts alpha 0..255 to blending weight 0..32 (private)
+ */
+static inline uint16_t blend_weight(uint8_t alpha)
+{
+	return (alpha + 4) >> 3;
+}
+
+/**
+ * Blends n pixels of a source row into dst (private)
+ * @dst: background pixels, replaced by the result
+ * @s: source
+ * @sx, @sy: source position of the first pixel
+ * @n: amount of pixels
+ */
+static void blend_row(uint16_t *dst, const blend_src *s, uint16_t sx, uint16_t sy, uint16_t n)
+{
+	uint32_t a = s->alpha;
+
+	if (s->mask == NULL && s->pixels == NULL) {
+		// Color and weight are constant: one multiply-add per pixel
+		uint32_t f = tft_rgb_spread(s->color) * a;
+		uint32_t ia = 32 - a;
+		for (uint16_t i = 0; i < n; i++) {
+			dst[i] = tft_rgb_pack((f + tft_rgb_spread(dst[i]) * ia) >> 5);
+		}
+	} else if (s->mask == NULL) {
+		const uint16_t *src = &s->pixels[(uint32_t)sy * s->width + sx];
+		uint32_t ia = 32 - a;
+		for (uint16_t i = 0; i < n; i++) {
+			dst[i] = tft_rgb_pack((tft_rgb_spread(src[i]) * a + tft_rgb_spread(dst[i]) * ia) >> 5);
+		}
+	} else {
+		const uint16_t *src = (s->pixels != NULL) ? &s->pixels[(uint32_t)sy * s->width + sx] : NULL;
+		uint32_t f = tft_rgb_spread(s->color);
+		for (uint16_t i = 0; i < n; i++) {
+			uint32_t w = (tft_mask_alpha(s->mask, s->fmt, s->width, sx + i, sy) * a + 128) >> 8;
+			if (w == 0) continue;
+			if (src != NULL) f = tft_rgb_spread(src[i]);
+			dst[i] = tft_rgb_pack((f * w + tft_rgb_spread(dst[i]) * (32 - w)) >> 5);
+		}
+	}
+}
+
+/**
+ * Blends source over a screen rectangle, clipped, chunk by chunk (private)
+ * @x, @y: top left corner of the source on the screen
+ * @w, @h: source size
+ * @s: source
+ * @return: TFT_EOK if success, TFT_ERANGE if nothing is visible or an error of
+ *          tft_read_pixels() (e.g. TFT_EUNAVAILABLE while recording a display list)
+ *
+ * Note: chunks are whole rows when the source is narrow, so one read and one write
+ * frame cover up to TFT_BLEND_CHUNK pixels.
+ */
+static tft_err blend_area(int32_t x, int32_t y, uint16_t w, uint16_t h, const blend_src *s)
+{
+	uint16_t buf[TFT_BLEND_CHUNK];
+	tft_rect c;
+
+	if (w == 0 || h == 0 || !tft_get_clip(&c)) return TFT_ERANGE;
+	int32_t x1 = max(x, (int32_t)c.x1), y1 = max(y, (int32_t)c.y1);
+	int32_t x2 = min(x + w - 1, (int32_t)c.x2), y2 = min(y + h - 1, (int32_t)c.y2);
+	if (x1 > x2 || y1 > y2) return TFT_ERANGE;
+	if (s->alpha == 0) return TFT_EOK;
+
+	uint16_t width = x2 - x1 + 1;
+	uint16_t seg = min(width, (uint16_t)TFT_BLEND_CHUNK);
+	uint16_t rows = (width > TFT_BLEND_CHUNK) ? 1 : TFT_BLEND_CHUNK / width;
+
+	for (int32_t cy = y1; cy <= y2; cy += rows) {
+		uint16_t nr = min((int32_t)rows, y2 - cy + 1);
+		for (int32_t cx = x1; cx <= x2; cx += seg) {
+			uint16_t nw = min((int32_t)seg, x2 - cx + 1);
+			tft_err err = tft_read_pixels(cx, cy, nw, nr, buf);
+			if (err) return err;
+			for (uint16_t j = 0; j < nr; j++) {
+				blend_row(&buf[j * nw], s, cx - x, cy - y + j, nw);
+			}
+			if (tft_set_frame(cx, cy, cx + nw - 1, cy + nr - 1)) return TFT_ERANGE;
+			tft_write_pixels(buf, (uint32_t)nw * nr);
+		}
+	}
+	return TFT_EOK;
+}
+
+/**
+ * Blends two colors
+ * @fg: foreground color
+ * @bg: background color
+ * @alpha: opacity of the foreground
+ * @return: blended color
+ */
+uint16_t tft_blend_color(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+	uint32_t a = blend_weight(alpha);
+	return tft_rgb_pack((tft_rgb_spread(fg) * a + tft_rgb_spread(bg) * (32 - a)) >> 5);
+}
+
+/**
+ * Fills translucent rectangle
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @longX: x axis length
+ * @longY: y axis length
+ * @color: fill color
+ * @alpha: opacity
+ * @return: TFT_EOK if success, TFT_ERANGE if nothing is visible or TFT_EUNAVAILABLE if
+ *          the background can't be read
+ */
+tft_err tft_fill_rect_blend(uint16_t x, uint16_t y, uint16_t longX, uint16_t longY,
+		                    uint16_t color, uint8_t alpha)
+{
+	blend_src s = {.color = color, .width = longX, .alpha = blend_weight(alpha)};
+	return blend_area(x, y, longX, longY, &s);
+}
+
+/**
+ * Draws translucent picture
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @img: image data array of 16 bit words as for tft_pic_from_flash()
+ * @mask: alpha of every pixel or NULL if the picture is uniformly translucent
+ * @fmt: format of the mask
+ * @alpha: opacity of the whole picture, multiplies the mask
+ * @return: TFT_EOK if success, TFT_EWRONGARG if img is NULL, TFT_ERANGE if nothing
+ *          is visible or TFT_EUNAVAILABLE if the background can't be read
+ */
+tft_err tft_pic_blend(uint16_t x, uint16_t y, const uint16_t *img, const uint8_t *mask,
+		              enum tft_alpha_fmt fmt, uint8_t alpha)
+{
+	if (img == NULL) return TFT_EWRONGARG;
+	blend_src s = {.pixels = &img[2], .mask = mask, .fmt = fmt, .width = img[0],
+			       .alpha = blend_weight(alpha)};
+	return blend_area(x, y, img[0], img[1], &s);
+}
+
+/**
+ * Fills pixels of a mask with translucent color, e.g. antialiased icons
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @w: mask width
+ * @h: mask height
+ * @mask: alpha of every pixel
+ * @fmt: format of the mask
+ * @color: fill color
+ * @alpha: opacity, multiplies the mask
+ * @return: TFT_EOK if success, TFT_EWRONGARG if mask is NULL, TFT_ERANGE if nothing
+ *          is visible or TFT_EUNAVAILABLE if the background can't be read
+ */
+tft_err tft_fill_mask_blend(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *mask,
+		                    enum tft_alpha_fmt fmt, uint16_t color, uint8_t alpha)
+{
+	if (mask == NULL) return TFT_EWRONGARG;
+	blend_src s = {.mask = mask, .fmt = fmt, .width = w, .color = color,
+			       .alpha = blend_weight(alpha)};
+	return blend_area(x, y, w, h, &s);
+}
+
+/**
+ * Prints translucent char in the font color, the background shows through
+ * @x: start coordinate x
+ * @y: start coordinate y
+ * @ascii: ASCII symbol
+ * @alpha: opacity of the symbol
+ * @return: TFT_EOK if success, TFT_ERANGE if nothing is visible or TFT_EUNAVAILABLE if
+ *          the background can't be read
+ */
+tft_err tft_print_char_blend(uint16_t x, uint16_t y, uint16_t ascii, uint8_t alpha)
+{
+	tft_glyph g;
+
+	tft_font_get_glyph(ascii, &g);
+	if (g.width == 0) return TFT_EOK;		// Blank symbol of a proportional font
+	return tft_fill_mask_blend(x + g.x, y + g.y, g.width, g.height, g.bits,
+			                   TFT_ALPHA_A1, font_color, alpha);
+}
+
+/**
+ * Prints translucent string, wraps as tft_print_str()
+ * @x: coordinate x of first symbol
+ * @y: coordinate y of first symbol
+ * @str: string to print
+ * @alpha: opacity of symbols
+ * @return: TFT_EOK if success or the error of the last failed symbol
+ */
+tft_err tft_print_str_blend(uint16_t x, uint16_t y, const char *str, uint8_t alpha)
+{
+	tft_err err = TFT_EOK;
+	while (*str != 0) {
+		if (x + tft_char_advance(*str, 0) > disp_orient.width) {
+			y += font_height; x = 0;
+		}
+		if (y > disp_orient.hight - font_height) {
+			y = 0; x = 0;
+		}
+		tft_err e = tft_print_char_blend(x, y, *str, alpha);
+		if (e) err = e;
+		x += tft_char_advance(*str, str[1]);
+		str++;
+	}
+	return err;
+}
+
+/**
+ *                                      ANTIALIASING
+ * Wu's algorithm: along the major axis u the ideal curve at v + f (f is the fraction)
+ * covers pixel v by 1 - f and pixel v + 1 by f. Steps with the same v make a run,
+ * the run is one rectangle of 2 rows (or columns) and goes to the controller as one
+ * frame. Runs are built in u, v coordinates and mapped to the screen: a line is one
+ * octant, a circle is one octant mirrored 8 times.
+ */
+
+/*Longest run, both of its rows fit a blending chunk*/
+#define AA_RUN_MAX		(TFT_BLEND_CHUNK / 2)
+
+/*Run of steps u0 + i covering (u0 + i, v) by w[0][i] and (u0 + i, v + 1) by w[1][i], 0..32*/
+typedef struct {
+	int16_t u0, v;
+	uint8_t n;
+	bool lower;					// Some pixel of v + 1 is covered
+	uint8_t w[2][AA_RUN_MAX];
+} aa_run;
+
+/*Mapping of u, v to the screen: x = x0 + su * u, y = y0 + sv * v, or swapped*/
+typedef struct {
+	int16_t x0, y0;
+	int8_t su, sv;
+	bool swap;					// u goes along y
+} aa_map;
+
+/*Background of antialiased pixels*/
+static bool aa_read_back = false;
+static uint16_t aa_back = BLACK;
+
+/**
+ * Blends a run into its screen rectangle, clipped (private)
+ * @run: run to draw
+ * @m: mapping to the screen
+ * @first: steps of the run to skip, mirrored octants don't repeat the axis pixel
+ * @color: line color
+ * @return: TFT_EOK or the error of tft_read_pixels()
+ */
+static tft_err aa_emit(const aa_run *run, const aa_map *m, uint8_t first, uint16_t color)
+{
+	uint16_t buf[TFT_BLEND_CHUNK];
+	int16_t n = run->n - first;
+	int16_t u0 = run->u0 + first;
+	int16_t rows_v = run->lower ? 2 : 1;
+	tft_rect c;
+
+	if (n <= 0 || !tft_get_clip(&c)) return TFT_EOK;
+	// Run extent along u and v on the screen
+	int32_t ua = (m->su > 0) ? u0 : -(u0 + n - 1);
+	int32_t va = (m->sv > 0) ? run->v : -(run->v + rows_v - 1);
+	int32_t x = (m->swap ? m->x0 + va : m->x0 + ua);
+	int32_t y = (m->swap ? m->y0 + ua : m->y0 + va);
+	int32_t w = m->swap ? rows_v : n;
+	int32_t h = m->swap ? n : rows_v;
+
+	int32_t x1 = max(x, (int32_t)c.x1), y1 = max(y, (int32_t)c.y1);
+	int32_t x2 = min(x + w - 1, (int32_t)c.x2), y2 = min(y + h - 1, (int32_t)c.y2);
+	if (x1 > x2 || y1 > y2) return TFT_EOK;
+	uint16_t vw = x2 - x1 + 1, vh = y2 - y1 + 1;
+
+	if (aa_read_back) {
+		tft_err err = tft_read_pixels(x1, y1, vw, vh, buf);
+		if (err) return err;
+	}
+	uint32_t f = tft_rgb_spread(color);
+	uint32_t b = tft_rgb_spread(aa_back);
+	uint16_t *px = buf;
+	for (int32_t r = y1 - y; r <= y2 - y; r++) {
+		for (int32_t col = x1 - x; col <= x2 - x; col++, px++) {
+			int32_t a = m->swap ? r : col;		// Step along u
+			int32_t k = m->swap ? col : r;		// Row of v
+			uint8_t i = (m->su > 0) ? a : n - 1 - a;
+			uint32_t wt = run->w[(m->sv > 0) ? k : rows_v - 1 - k][first + i];
+			if (aa_read_back) b = tft_rgb_spread(*px);
+			*px = tft_rgb_pack((f * wt + b * (32 - wt)) >> 5);
+		}
+	}
+	if (tft_set_frame(x1, y1, x2, y2)) return TFT_ERANGE;
+	tft_write_pixels(buf, (uint32_t)vw * vh);
+	return TFT_EOK;
+}
+
+/**
+ * Draws the run for every mapping and empties it (private)
+ */
+static tft_err aa_flush(aa_run *run, const aa_map *m, uint8_t n_map, uint16_t color)
+{
+	tft_err err = TFT_EOK;
+	for (uint8_t j = 0; j < n_map; j++) {
+		uint8_t first = (m[j].su < 0 && run->u0 == 0) ? 1 : 0;
+		tft_err e = aa_emit(run, &m[j], first, color);
+		if (e) err = e;
+	}
+	run->n = 0;
+	return err;
+}
+
+/**
+ * Adds a step to the run, a full or moved run is drawn first (private)
+ * @run: run being built, zero n before the first step
+ * @m: mappings to the screen
+ * @n_map: amount of mappings
+ * @u, @v: step
+ * @frac: coverage of v + 1, 0..31
+ * @color: line color
+ * @return: TFT_EOK or the error of tft_read_pixels()
+ */
+static tft_err aa_step(aa_run *run, const aa_map *m, uint8_t n_map, int16_t u, int16_t v,
+		               uint8_t frac, uint16_t color)
+{
+	tft_err err = TFT_EOK;
+	if (run->n != 0 && (v != run->v || run->n == AA_RUN_MAX)) err = aa_flush(run, m, n_map, color);
+	if (run->n == 0) {
+		run->u0 = u;
+		run->v = v;
+		run->lower = false;
+	}
+	run->w[0][run->n] = 32 - frac;
+	run->w[1][run->n] = frac;
+	run->lower |= (frac != 0);
+	run->n++;
+	return err;
+}
+
+/**
+ * Sets what antialiased pixels are blended with
+ * @read_back: true to blend with the content read by tft_read_pixels() (GRAM or band
+ *             strip), false to blend with the color, which costs no reads
+ * @color: background color, used if read_back is false (default BLACK)
+ */
+void tft_set_aa_background(bool read_back, uint16_t color)
+{
+	aa_read_back = read_back;
+	aa_back = color;
+}
+
+/**
+ * Drawing the antialiased line 1 pixel wide (Wu's algorithm)
+ * @x1: line start coordinate x
+ * @y1: line start coordinate y
+ * @x2: line end coordinate x
+ * @y2: line end coordinate y
+ * @color: line color
+ * @return: TFT_EOK if success or TFT_EUNAVAILABLE if the background can't be read
+ *
+ * Note: pixels of a step along the major axis are grouped into runs of 2 by n pixels,
+ * one frame each, so a line costs about as many frames as tft_draw_line().
+ */
+tft_err tft_draw_line_aa(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+{
+	bool steep = abs(y2 - y1) > abs(x2 - x1);
+	aa_map m = {.x0 = 0, .y0 = 0, .su = 1, .sv = 1, .swap = steep};
+	int16_t u1 = steep ? y1 : x1, v1 = steep ? x1 : y1;
+	int16_t u2 = steep ? y2 : x2, v2 = steep ? x2 : y2;
+	aa_run run = {.n = 0};
+	tft_err err = TFT_EOK;
+
+	if (u1 > u2) {
+		swap(u1, u2);
+		swap(v1, v2);
+	}
+	int32_t grad = (u2 != u1) ? ((int32_t)(v2 - v1) << 16) / (u2 - u1) : 0;
+	int32_t v = (int32_t)v1 << 16;			// 16.16 fixed point, never below min(v1, v2)
+
+	for (int16_t u = u1; u <= u2; u++, v += grad) {
+		tft_err e = aa_step(&run, &m, 1, u, v >> 16, (v >> 11) & 31, color);
+		if (e) err = e;
+	}
+	tft_err e = aa_flush(&run, &m, 1, color);
+	return e ? e : err;
+}
+
+/**
+ * Drawing the antialiased circle 1 pixel wide (Wu's algorithm)
+ * @x0: center coordinate x
+ * @y0: center coordinate y
+ * @radius: radius
+ * @color: line color
+ * @return: TFT_EOK if success or TFT_EUNAVAILABLE if the background can't be read
+ *
+ * Note: one octant is computed and drawn mirrored 8 times, runs as in tft_draw_line_aa().
+ */
+tft_err tft_draw_circle_aa(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color)
+{
+	aa_map m[8];
+	aa_run run = {.n = 0};
+	tft_err err = TFT_EOK;
+	float rr = (float)radius * radius;
+
+	for (uint8_t j = 0; j < 8; j++) {
+		m[j].x0 = x0;
+		m[j].y0 = y0;
+		m[j].su = (j & 1) ? -1 : 1;
+		m[j].sv = (j & 2) ? -1 : 1;
+		m[j].swap = (j & 4) != 0;
+	}
+	for (int16_t u = 0; ; u++) {
+		float ve = sqrtf(rr - (float)u * u);
+		if (u > ve) break;					// Octant ends at the diagonal
+		int16_t v = (int16_t)ve;
+		uint8_t frac = (uint8_t)((ve - v) * 32.0f);
+		if (v == u) {
+			// Last step is on the diagonal: swapping maps (u, v) to itself, so the
+			// swapped octants get only (u, v + 1)
+			tft_err e = aa_flush(&run, m, 8, color);
+			if (e) err = e;
+			aa_step(&run, m, 4, u, v, frac, color);
+			e = aa_flush(&run, m, 4, color);
+			if (e) err = e;
+			if (frac != 0) {
+				run = (aa_run){.u0 = u, .v = v + 1, .n = 1};
+				run.w[0][0] = frac;
+				e = aa_flush(&run, m + 4, 4, color);
+				if (e) err = e;
+			}
+			return err;
+		}
+		tft_err e = aa_step(&run, m, 8, u, v, frac, color);
+		if (e) err = e;
+	}
+	tft_err e = aa_flush(&run, m, 8, color);
+	return e ? e : err;
+}
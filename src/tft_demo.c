@@ -5,6 +5,7 @@
 #include "xpt2046.h"
 
 #include <libopencm3/cm3/cortex.h>
+#include <libopencm3/cm3/dwt.h>
 #include <libopencm3/cm3/nvic.h>
 #include <libopencm3/stm32/pwr.h>
 
@@ -17,7 +18,11 @@ int main(void)
 	/*Enable interrupts globally*/
 	cm_enable_interrupts();
 	/*Configuration and initialization data pins*/
+#if ILI9325_BUS == _BUS_FSMC
+	fsmc_tft_init();
+#else
 	pins_tft_init(&ili9325_data_pins);
+#endif
 	/*Configuration and initialization control pins*/
 	pins_tft_init(&ili9325_ctrl_pins);
 	pins_touch_init(&touch_spi_pins, &touch_cs_pin);
@@ -82,6 +87,23 @@ int main(void)
 	tft_fill_triangle(250, 150, 280, 200, 200, 200, BLUE);
 	cont_tick_delay_ms(3000);
 
+	/*Bus throughput demo: CPU cycles per pixel for a fill and a blit*/
+	dwt_enable_cycle_counter();
+	uint32_t cycles = dwt_read_cycle_counter();
+	tft_fill_screen(BLACK);
+	uint32_t fill_cycles = dwt_read_cycle_counter() - cycles;
+	cycles = dwt_read_cycle_counter();
+	tft_pic_from_flash(5, 5, linux_pict);
+	uint32_t blit_cycles = dwt_read_cycle_counter() - cycles;
+	uint32_t fill_px = 320ul * 240ul;
+	uint32_t blit_px = (uint32_t)linux_pict[0] * linux_pict[1];
+	tft_set_font(COURIER_NEW_8_NORM, WHITE, BLACK);
+	tft_set_cursor(0, 200);
+	tft_printf("fill: %lu.%02lu cycles/px\r\nblit: %lu.%02lu cycles/px\r\n",
+			fill_cycles / fill_px, fill_cycles % fill_px * 100 / fill_px,
+			blit_cycles / blit_px, blit_cycles % blit_px * 100 / blit_px);
+	cont_tick_delay_ms(3000);
+
 	/*Drawing picture from flash demo*/
 	tft_fill_screen(BLACK);
 	tft_pic_from_flash(5, 5, linux_pict);
@@ -0,0 +1,192 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "tft_dirty.h"
+#include "ili9325.h"
+#include "macro.h"
+#include <stddef.h>
+
+/**
+ *                                    DIRTY RECTANGLES
+ * Painting regions a and b apart costs 2 setups plus both areas, painting their bounding
+ * box costs 1 setup plus its area. So they are merged when
+ * area(box) - area(a) - area(b) <= setup cost. Overlapping regions are merged anyway,
+ * so no pixel is repainted twice. A merged region, forced ones too, is checked against
+ * the others again, as it may now be close to them.
+ */
+
+/*Dirty regions of the coming frame*/
+static tft_rect rects[TFT_DIRTY_RECTS_MAX];
+static uint16_t n_rects = 0;
+
+static tft_dirty_repaint_cb repaint_cb = NULL;
+static void *repaint_ctx = NULL;
+static uint32_t setup_cost = TFT_DIRTY_SETUP_COST;
+
+/*Statistics of the coming and the last frames*/
+static tft_dirty_stats stats_next;
+static tft_dirty_stats stats_last;
+
+static inline uint32_t rect_area(const tft_rect *r)
+{
+	return (uint32_t)(r->x2 - r->x1 + 1) * (r->y2 - r->y1 + 1);
+}
+
+static inline tft_rect rect_union(const tft_rect *a, const tft_rect *b)
+{
+	tft_rect u = {min(a->x1, b->x1), min(a->y1, b->y1), max(a->x2, b->x2), max(a->y2, b->y2)};
+	return u;
+}
+
+static inline bool rect_overlap(const tft_rect *a, const tft_rect *b)
+{
+	return a->x1 <= b->x2 && b->x1 <= a->x2 && a->y1 <= b->y2 && b->y1 <= a->y2;
+}
+
+/**
+ * Pixels painted extra if the regions are merged (private)
+ * @return: extra pixels, overlap is subtracted twice
+ */
+static int32_t merge_extra(const tft_rect *a, const tft_rect *b)
+{
+	tft_rect u = rect_union(a, b);
+	return (int32_t)rect_area(&u) - (int32_t)rect_area(a) - (int32_t)rect_area(b);
+}
+
+/**
+ * Removes region i from the list (private)
+ */
+static void rect_remove(uint16_t i)
+{
+	rects[i] = rects[--n_rects];
+}
+
+/**
+ * Merges into a region every listed region cheap enough to merge with it (private)
+ * @r: region, not in the list
+ *
+ * Note: overlapping regions are always merged, so no pixel is repainted twice.
+ */
+static void rect_absorb(tft_rect *r)
+{
+	for (uint16_t i = 0; i < n_rects; ) {
+		if (rect_overlap(r, &rects[i]) || merge_extra(r, &rects[i]) <= (int32_t)setup_cost) {
+			*r = rect_union(r, &rects[i]);
+			rect_remove(i);
+			i = 0;				// Bigger region may reach the ones already passed
+		} else {
+			i++;
+		}
+	}
+}
+
+/**
+ * Sets region repaint callback
+ * @repaint: callback called by tft_dirty_flush() for every region
+ * @ctx: argument for the callback
+ */
+void tft_dirty_set_repaint(tft_dirty_repaint_cb repaint, void *ctx)
+{
+	repaint_cb = repaint;
+	repaint_ctx = ctx;
+}
+
+/**
+ * Sets cost of one more region in pixels, the coalescing threshold
+ * @cost: pixels that could be written instead of setting up a region
+ *
+ * Note: with 0 regions are merged only if no extra pixels are painted.
+ */
+void tft_dirty_set_cost(uint32_t cost)
+{
+	setup_cost = cost;
+}
+
+/**
+ * Marks a screen area to be repainted by the next tft_dirty_flush()
+ * @rect: area, clipped to the screen
+ * @return: TFT_EOK if success or TFT_EWRONGARG if rect is NULL or reversed
+ */
+tft_err tft_invalidate(const tft_rect *rect)
+{
+	if (rect == NULL || rect->x2 < rect->x1 || rect->y2 < rect->y1) return TFT_EWRONGARG;
+	if (rect->x1 >= disp_orient.width || rect->y1 >= disp_orient.hight) return TFT_EOK;
+
+	tft_rect r = *rect;
+	r.x2 = min(r.x2, disp_orient.width - 1);
+	r.y2 = min(r.y2, disp_orient.hight - 1);
+	stats_next.invalidates++;
+	stats_next.dirty += rect_area(&r);
+
+	rect_absorb(&r);
+
+	if (n_rects == TFT_DIRTY_RECTS_MAX) {
+		// No room: merge the cheapest pair, the new region is one of the candidates
+		uint16_t best_i = 0, best_j = n_rects;
+		int32_t best = INT32_MAX;
+		for (uint16_t i = 0; i < n_rects; i++) {
+			for (uint16_t j = i + 1; j <= n_rects; j++) {
+				int32_t extra = merge_extra(&rects[i], (j == n_rects) ? &r : &rects[j]);
+				if (extra < best) {
+					best = extra;
+					best_i = i;
+					best_j = j;
+				}
+			}
+		}
+		if (best_j == n_rects) {
+			r = rect_union(&r, &rects[best_i]);
+			rect_remove(best_i);
+		} else {
+			tft_rect m = rect_union(&rects[best_i], &rects[best_j]);
+			rect_remove(best_j);				// best_i < best_j stays in place
+			rects[best_i] = r;
+			r = m;
+		}
+		rect_absorb(&r);						// Merged region may reach others
+		stats_next.forced++;
+	}
+	rects[n_rects++] = r;
+	return TFT_EOK;
+}
+
+/**
+ * Repaints dirty regions and clears them, call once per frame
+ * @return: TFT_EOK if success or TFT_EUNAVAILABLE if no repaint callback is set
+ *
+ * Note: the callback may invalidate areas, they are repainted by the next flush.
+ */
+tft_err tft_dirty_flush(void)
+{
+	tft_rect frame[TFT_DIRTY_RECTS_MAX];
+	uint16_t n = n_rects;
+
+	if (repaint_cb == NULL) return TFT_EUNAVAILABLE;
+	for (uint16_t i = 0; i < n; i++) {
+		frame[i] = rects[i];
+	}
+	stats_last = stats_next;
+	stats_last.regions = n;
+	stats_last.pixels = 0;
+	n_rects = 0;
+	stats_next = (tft_dirty_stats){0};
+
+	for (uint16_t i = 0; i < n; i++) {
+		stats_last.pixels += rect_area(&frame[i]);
+		repaint_cb(&frame[i], repaint_ctx);
+	}
+	return TFT_EOK;
+}
+
+/**
+ * Gets statistics of the last flushed frame
+ * @stats: where to store them
+ */
+void tft_dirty_get_stats(tft_dirty_stats *stats)
+{
+	if (stats != NULL) *stats = stats_last;
+}
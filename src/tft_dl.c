@@ -0,0 +1,399 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "tft_dl.h"
+#include "ili9325.h"
+#include "macro.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ *                                     DISPLAY LISTS
+ * Recording swaps tft pixel functions like the band renderer does. The pixel runs sent to
+ * a frame are cut into rectangles: the rest of a started row, whole rows, the start of a
+ * row. So primitives need no changes and are recorded exactly as they draw.
+ * Commands are 16 bytes. Images in the internal flash are referenced, pixels anywhere
+ * else (SRAM, CCM RAM, e.g. glyph rows built on the stack) are copied to the arena end.
+ * Image rows continuing the last command are joined into it, so a glyph sent row by row
+ * replays as one frame instead of a frame per row.
+ */
+
+/*How far ahead a fill looks for a fill to merge with*/
+#define DL_MERGE_WINDOW		8
+
+/*Largest copied image a row is joined to, joining moves the copied pixels*/
+#define DL_JOIN_MAX			2048
+
+/*Pixels in the internal flash stay valid and are referenced, others are copied*/
+#define DL_IN_FLASH(p)		((uintptr_t)(p) >= TFT_DL_FLASH_START && (uintptr_t)(p) < TFT_DL_FLASH_END)
+
+/*List being recorded*/
+static tft_dl *rec = NULL;
+
+/*Panel functions saved while recording*/
+static tft_pixel_ops panel;
+
+/*Current frame and position in it*/
+static struct {
+	uint16_t x1, y1, x2, y2;
+	uint16_t x, y;
+} frame;
+
+/**
+ * Joins image rows below the last command into it (private)
+ * @src: pixels of the rows
+ * @copy: pixels must be copied to the arena
+ * @return: joined command or NULL if the rows don't continue the last command
+ *
+ * Note: copied pixels of the last command are at the arena end, they are moved down
+ * to make room for the new rows after them.
+ */
+static tft_dl_cmd *dl_join(const uint16_t *src, bool copy,
+		                   uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	uint32_t n = (uint32_t)(x2 - x1 + 1) * (y2 - y1 + 1);
+	tft_dl_cmd *last;
+	uint32_t had;
+
+	if (rec->n == 0) return NULL;
+	last = &rec->cmd[rec->n - 1];
+	if (last->op != TFT_DL_IMAGE) return NULL;
+	if (last->x1 != x1 || last->x2 != x2 || last->y2 + 1 != y1) return NULL;
+	had = (uint32_t)(x2 - x1 + 1) * (last->y2 - last->y1 + 1);
+	if (!copy) {
+		if (DL_IN_FLASH(last->src) && last->src + had == src) {
+			last->y2 = y2;
+			return last;
+		}
+		return NULL;
+	}
+	if (last->src != rec->data || had + n > DL_JOIN_MAX) return NULL;
+	if ((uint32_t)((uint8_t *)rec->data - (uint8_t *)&rec->cmd[rec->n]) < n * sizeof(uint16_t)) {
+		return NULL;
+	}
+	memmove(rec->data - n, rec->data, had * sizeof(uint16_t));
+	rec->data -= n;
+	memcpy(rec->data + had, src, n * sizeof(uint16_t));
+	last->src = rec->data;
+	last->y2 = y2;
+	return last;
+}
+
+/**
+ * Appends command, pixels of the image are copied if needed (private)
+ * @return: command or NULL if the arena is full
+ */
+static tft_dl_cmd *dl_add(uint8_t op, uint16_t color, const uint16_t *src,
+		                  uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+	uint32_t n = (uint32_t)(x2 - x1 + 1) * (y2 - y1 + 1);
+	bool copy = (op == TFT_DL_IMAGE) && !DL_IN_FLASH(src);
+	tft_dl_cmd *cmd = &rec->cmd[rec->n];
+	uint32_t room = (uint32_t)((uint8_t *)rec->data - (uint8_t *)cmd);
+
+	if (rec->full) return NULL;
+	if (op == TFT_DL_IMAGE) {
+		tft_dl_cmd *joined = dl_join(src, copy, x1, y1, x2, y2);
+		if (joined != NULL) return joined;
+	}
+	if (room < sizeof(*cmd) + (copy ? n * sizeof(uint16_t) : 0)) {
+		rec->full = true;
+		return NULL;
+	}
+	if (copy) {
+		rec->data -= n;
+		memcpy(rec->data, src, n * sizeof(uint16_t));
+		src = rec->data;
+	}
+	cmd->op = op;
+	cmd->reserved = 0;
+	cmd->color = color;
+	cmd->x1 = x1;
+	cmd->y1 = y1;
+	cmd->x2 = x2;
+	cmd->y2 = y2;
+	cmd->src = src;
+	rec->n++;
+	return cmd;
+}
+
+/**
+ * Cuts n pixels of the frame into rectangle commands (private)
+ * @src: pixels or NULL for a fill
+ * @color: fill color
+ * @n: amount of pixels
+ */
+static void dl_run(const uint16_t *src, uint16_t color, uint32_t n)
+{
+	uint8_t op = (src != NULL) ? TFT_DL_IMAGE : TFT_DL_FILL;
+	uint16_t width = frame.x2 - frame.x1 + 1;
+
+	if (frame.x2 < frame.x1 || frame.y2 < frame.y1) return;
+	while (n != 0) {
+		uint32_t k;
+		if (frame.x != frame.x1 || n < width) {
+			// Part of a row
+			k = min(n, (uint32_t)(frame.x2 - frame.x + 1));
+			dl_add(op, color, src, frame.x, frame.y, frame.x + k - 1, frame.y);
+			frame.x += k;
+			if (frame.x > frame.x2) {
+				frame.x = frame.x1;
+				frame.y = (frame.y == frame.y2) ? frame.y1 : frame.y + 1;
+			}
+		} else {
+			// Whole rows
+			uint16_t rows = min(n / width, (uint32_t)(frame.y2 - frame.y + 1));
+			k = (uint32_t)rows * width;
+			dl_add(op, color, src, frame.x1, frame.y, frame.x2, frame.y + rows - 1);
+			frame.y += rows;
+			if (frame.y > frame.y2) frame.y = frame.y1;
+		}
+		if (src != NULL) src += k;
+		n -= k;
+	}
+}
+
+static tft_err dl_set_frame(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2)
+{
+	if ((w1 >= disp_orient.width)||(h1 >= disp_orient.hight)
+	    ||(w2 >= disp_orient.width)||(h2 >= disp_orient.hight)){
+		return TFT_ERANGE;
+	}
+	frame.x1 = frame.x = w1;
+	frame.y1 = frame.y = h1;
+	frame.x2 = w2;
+	frame.y2 = h2;
+	return TFT_EOK;
+}
+
+static void dl_fill_pixels(uint16_t color, uint32_t n)
+{
+	dl_run(NULL, color, n);
+}
+
+static void dl_write_pixels(const uint16_t *src, uint32_t n)
+{
+	dl_run(src, 0, n);
+}
+
+static void dl_frame_draw_pixel(uint16_t color)
+{
+	dl_run(NULL, color, 1);
+}
+
+static void dl_fill_screen(uint16_t color)
+{
+	dl_add(TFT_DL_FILL, color, NULL, 0, 0, disp_orient.width - 1, disp_orient.hight - 1);
+}
+
+static tft_err dl_read_pixels(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst)
+{
+	(void)x; (void)y; (void)w; (void)h; (void)dst;
+	return TFT_EUNAVAILABLE;				// Pixels are not known before submission
+}
+
+static tft_err dl_fill_pixels_async(uint16_t color, uint32_t n, void (*done)(void))
+{
+	if (n == 0) return TFT_EWRONGARG;
+	dl_run(NULL, color, n);
+	if (done != NULL) done();
+	return TFT_EOK;
+}
+
+static tft_err dl_write_pixels_async(const uint16_t *src, uint32_t n, void (*done)(void))
+{
+	if (src == NULL || n == 0) return TFT_EWRONGARG;
+	dl_run(src, 0, n);
+	if (done != NULL) done();
+	return TFT_EOK;
+}
+
+static void dl_wait_idle(void)
+{
+}
+
+/*Pixel functions recording into the list*/
+static const tft_pixel_ops dl_ops = {
+	.set_frame = dl_set_frame,
+	.fill_screen = dl_fill_screen,
+	.frame_draw_pixel = dl_frame_draw_pixel,
+	.write_pixels = dl_write_pixels,
+	.fill_pixels = dl_fill_pixels,
+	.read_pixels = dl_read_pixels,
+	.fill_pixels_async = dl_fill_pixels_async,
+	.write_pixels_async = dl_write_pixels_async,
+	.wait_idle = dl_wait_idle
+};
+
+/**
+ * Checks whether rectangle a is inside rectangle b (private)
+ */
+static inline bool dl_inside(const tft_dl_cmd *a, const tft_dl_cmd *b)
+{
+	return a->x1 >= b->x1 && a->x2 <= b->x2 && a->y1 >= b->y1 && a->y2 <= b->y2;
+}
+
+/**
+ * Checks whether rectangles overlap (private)
+ */
+static inline bool dl_overlap(const tft_dl_cmd *a, const tft_dl_cmd *b)
+{
+	return a->x1 <= b->x2 && b->x1 <= a->x2 && a->y1 <= b->y2 && b->y1 <= a->y2;
+}
+
+/**
+ * Merges fill b into fill a if together they form a rectangle (private)
+ * @return: true if merged
+ */
+static bool dl_merge(tft_dl_cmd *a, const tft_dl_cmd *b)
+{
+	if (a->op != TFT_DL_FILL || b->op != TFT_DL_FILL || a->color != b->color) return false;
+	if (a->x1 == b->x1 && a->x2 == b->x2 && (a->y2 + 1 == b->y1 || b->y2 + 1 == a->y1)) {
+		a->y1 = min(a->y1, b->y1);
+		a->y2 = max(a->y2, b->y2);
+		return true;
+	}
+	if (a->y1 == b->y1 && a->y2 == b->y2 && (a->x2 + 1 == b->x1 || b->x2 + 1 == a->x1)) {
+		a->x1 = min(a->x1, b->x1);
+		a->x2 = max(a->x2, b->x2);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Sort order of commands: by rows, then by columns (private)
+ * @return: true if a goes after b
+ *
+ * Note: frames on the same rows share window registers, which are not resent.
+ */
+static inline bool dl_after(const tft_dl_cmd *a, const tft_dl_cmd *b)
+{
+	if (a->y1 != b->y1) return a->y1 > b->y1;
+	if (a->y2 != b->y2) return a->y2 > b->y2;
+	return a->x1 > b->x1;
+}
+
+/**
+ * Drops removed commands (private)
+ */
+static void dl_compact(tft_dl *dl)
+{
+	uint32_t k = 0;
+	for (uint32_t i = 0; i < dl->n; i++) {
+		if (dl->cmd[i].op != TFT_DL_NOP) dl->cmd[k++] = dl->cmd[i];
+	}
+	dl->n = k;
+}
+
+/**
+ * Starts recording of a display list
+ * @dl: list to record
+ * @arena: memory for commands and copied pixels, must live as long as the list
+ * @size: arena size in bytes
+ * @return: TFT_EOK if success or TFT_EWRONGARG if wrong arguments or already recording
+ */
+tft_err tft_dl_begin(tft_dl *dl, void *arena, uint32_t size)
+{
+	if (dl == NULL || arena == NULL || rec != NULL) return TFT_EWRONGARG;
+	// Commands need 4 byte alignment, pixels 2 byte
+	uintptr_t start = ((uintptr_t)arena + 3) & ~(uintptr_t)3;
+	uintptr_t end = ((uintptr_t)arena + size) & ~(uintptr_t)1;
+	if (end < start) return TFT_EWRONGARG;
+
+	dl->cmd = (tft_dl_cmd *)start;
+	dl->n = 0;
+	dl->data = (uint16_t *)end;
+	dl->full = false;
+	rec = dl;
+	tft_get_pixel_ops(&panel);
+	tft_set_pixel_ops(&dl_ops);
+	return TFT_EOK;
+}
+
+/**
+ * Stops recording and optimizes the list: commands hidden by later ones are dropped,
+ * adjacent fills of the same color are merged, commands are sorted by position
+ * where they don't overlap.
+ * @dl: list being recorded
+ * @return: TFT_EOK if success, TFT_EWRONGARG if dl is not being recorded or
+ *          TFT_EFULL if the arena overflowed (the list can't be submitted)
+ */
+tft_err tft_dl_end(tft_dl *dl)
+{
+	if (dl == NULL || dl != rec) return TFT_EWRONGARG;
+	tft_set_pixel_ops(&panel);
+	rec = NULL;
+	if (dl->full) return TFT_EFULL;
+
+	tft_dl_cmd *cmd = dl->cmd;
+	// All commands are opaque: one inside a later one is never seen
+	for (uint32_t i = 0; i < dl->n; i++) {
+		for (uint32_t j = i + 1; j < dl->n; j++) {
+			if (cmd[j].op != TFT_DL_NOP && dl_inside(&cmd[i], &cmd[j])) {
+				cmd[i].op = TFT_DL_NOP;
+				break;
+			}
+		}
+	}
+	dl_compact(dl);
+
+	// Later fill moves back to the earlier one, so nothing in between may overlap it
+	for (uint32_t i = 0; i < dl->n; i++) {
+		uint32_t end = min(dl->n, i + 1 + DL_MERGE_WINDOW);
+		for (uint32_t j = i + 1; j < end; j++) {
+			if (cmd[j].op == TFT_DL_NOP) continue;
+			bool covered = false;
+			for (uint32_t k = i + 1; k < j && !covered; k++) {
+				covered = cmd[k].op != TFT_DL_NOP && dl_overlap(&cmd[k], &cmd[j]);
+			}
+			if (!covered && dl_merge(&cmd[i], &cmd[j])) {
+				cmd[j].op = TFT_DL_NOP;
+				j = i;				// Merged fill may join the ones already passed
+			}
+		}
+	}
+	dl_compact(dl);
+
+	// Stable insertion sort, overlapping commands keep their order
+	for (uint32_t i = 1; i < dl->n; i++) {
+		tft_dl_cmd c = cmd[i];
+		uint32_t k = i;
+		while (k > 0 && dl_after(&cmd[k - 1], &c) && !dl_overlap(&cmd[k - 1], &c)) {
+			cmd[k] = cmd[k - 1];
+			k--;
+		}
+		cmd[k] = c;
+	}
+	return TFT_EOK;
+}
+
+/**
+ * Draws the display list, may be called any number of times
+ * @dl: recorded list
+ * @return: TFT_EOK if success, TFT_EWRONGARG if dl is NULL or being recorded or
+ *          TFT_EFULL if the list is incomplete
+ *
+ * Note: drawing goes through the current tft pixel functions, so a list can be
+ * submitted from a tft_band_render() callback.
+ */
+tft_err tft_dl_submit(const tft_dl *dl)
+{
+	if (dl == NULL || dl == rec) return TFT_EWRONGARG;
+	if (dl->full) return TFT_EFULL;
+	for (uint32_t i = 0; i < dl->n; i++) {
+		const tft_dl_cmd *c = &dl->cmd[i];
+		uint32_t n = (uint32_t)(c->x2 - c->x1 + 1) * (c->y2 - c->y1 + 1);
+		if (tft_set_frame(c->x1, c->y1, c->x2, c->y2)) continue;
+		if (c->op == TFT_DL_FILL) {
+			tft_fill_pixels(c->color, n);
+		} else {
+			tft_write_pixels(c->src, n);
+		}
+	}
+	return TFT_EOK;
+}
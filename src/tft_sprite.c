@@ -0,0 +1,297 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "tft_sprite.h"
+#include "ili9325.h"
+#include "macro.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ *                                         SPRITES
+ * Background buffer has the layout of the picture: pixel (i, j) of the sprite rectangle
+ * is back[j * width + i]. Only pixels inside the clip rectangle are read, drawn and kept
+ * valid, so a sprite is shown, moved and hidden under the same clip.
+ * Sprites overlapping each other must be hidden in the reverse order of showing, like
+ * any save/restore scheme.
+ */
+
+/**
+ * Gets part of the sprite rectangle at x, y inside the clip rectangle (private)
+ * @return: false if nothing of it is visible
+ */
+static bool sprite_rect(const tft_sprite *s, int16_t x, int16_t y, tft_rect *r)
+{
+	tft_rect c;
+
+	if (!tft_get_clip(&c)) return false;
+	int32_t x1 = max((int32_t)x, (int32_t)c.x1), y1 = max((int32_t)y, (int32_t)c.y1);
+	int32_t x2 = min((int32_t)x + s->img[0] - 1, (int32_t)c.x2);
+	int32_t y2 = min((int32_t)y + s->img[1] - 1, (int32_t)c.y2);
+	if (x1 > x2 || y1 > y2) return false;
+	r->x1 = x1;
+	r->y1 = y1;
+	r->x2 = x2;
+	r->y2 = y2;
+	return true;
+}
+
+/**
+ * Splits a - b into up to 4 rectangles, b must be inside a (private)
+ * @return: amount of rectangles
+ */
+static uint8_t rect_sub(const tft_rect *a, const tft_rect *b, tft_rect out[4])
+{
+	uint8_t n = 0;
+	if (a->y1 < b->y1) out[n++] = (tft_rect){a->x1, a->y1, a->x2, b->y1 - 1};
+	if (b->y2 < a->y2) out[n++] = (tft_rect){a->x1, b->y2 + 1, a->x2, a->y2};
+	if (a->x1 < b->x1) out[n++] = (tft_rect){a->x1, b->y1, b->x1 - 1, b->y2};
+	if (b->x2 < a->x2) out[n++] = (tft_rect){b->x2 + 1, b->y1, a->x2, b->y2};
+	return n;
+}
+
+/**
+ * Reads the screen under a part of the sprite into the background buffer (private)
+ * @r: part on the screen
+ * @return: TFT_EOK or the error of tft_read_pixels()
+ *
+ * Note: narrow parts are read several rows at once through a chunk buffer.
+ */
+static tft_err sprite_save(tft_sprite *s, const tft_rect *r)
+{
+	uint16_t buf[TFT_SPRITE_CHUNK];
+	uint16_t width = s->img[0];
+	uint16_t rw = r->x2 - r->x1 + 1;
+	uint16_t *dst = &s->back[(uint32_t)(r->y1 - s->y) * width + (r->x1 - s->x)];
+
+	if (rw == width) {
+		// Whole rows are contiguous in the buffer
+		return tft_read_pixels(r->x1, r->y1, rw, r->y2 - r->y1 + 1, dst);
+	}
+	uint16_t seg = min(rw, (uint16_t)TFT_SPRITE_CHUNK);
+	uint16_t rows = (rw > TFT_SPRITE_CHUNK) ? 1 : TFT_SPRITE_CHUNK / rw;
+	for (int32_t y = r->y1; y <= r->y2; y += rows) {
+		uint16_t nr = min((int32_t)rows, r->y2 - y + 1);
+		for (int32_t x = r->x1; x <= r->x2; x += seg) {
+			uint16_t nw = min((int32_t)seg, r->x2 - x + 1);
+			tft_err err = tft_read_pixels(x, y, nw, nr, buf);
+			if (err) return err;
+			for (uint16_t j = 0; j < nr; j++) {
+				memcpy(&dst[(uint32_t)(y - r->y1 + j) * width + (x - r->x1)], &buf[j * nw],
+					   nw * sizeof(uint16_t));
+			}
+		}
+	}
+	return TFT_EOK;
+}
+
+/**
+ * Writes the saved background of a part of the sprite back to the screen (private)
+ * @r: part on the screen
+ */
+static void sprite_restore(const tft_sprite *s, const tft_rect *r)
+{
+	uint16_t width = s->img[0];
+	uint16_t rw = r->x2 - r->x1 + 1;
+	const uint16_t *src = &s->back[(uint32_t)(r->y1 - s->y) * width + (r->x1 - s->x)];
+
+	if (tft_set_frame(r->x1, r->y1, r->x2, r->y2)) return;
+	for (int32_t y = r->y1; y <= r->y2; y++, src += width) tft_write_pixels(src, rw);
+}
+
+/**
+ * Draws a part of the sprite over its saved background (private)
+ * @r: part on the screen
+ */
+static void sprite_draw(const tft_sprite *s, const tft_rect *r)
+{
+	uint16_t buf[TFT_SPRITE_CHUNK];
+	uint16_t width = s->img[0];
+
+	if (tft_set_frame(r->x1, r->y1, r->x2, r->y2)) return;
+	for (int32_t y = r->y1; y <= r->y2; y++) {
+		uint16_t j = y - s->y;
+		for (int32_t x = r->x1; x <= r->x2; ) {
+			uint16_t nw = min((int32_t)TFT_SPRITE_CHUNK, r->x2 - x + 1);
+			uint16_t i0 = x - s->x;
+			const uint16_t *px = &s->img[2 + (uint32_t)j * width + i0];	// Pixel colors follow the sizes
+			const uint16_t *back = &s->back[(uint32_t)j * width + i0];
+			for (uint16_t i = 0; i < nw; i++) {
+				uint16_t c = px[i];
+				if (s->keyed && c == s->key) {
+					c = back[i];
+				} else if (s->mask != NULL) {
+					uint8_t a = tft_mask_alpha(s->mask, s->fmt, width, i0 + i, j);
+					if (a != 255) c = tft_blend_color(c, back[i], a);
+				}
+				buf[i] = c;
+			}
+			tft_write_pixels(buf, nw);
+			x += nw;
+		}
+	}
+}
+
+/**
+ * Moves the saved background with the sprite, the overlap of places stays valid (private)
+ * @dx, @dy: move
+ */
+static void sprite_shift(tft_sprite *s, int32_t dx, int32_t dy)
+{
+	int32_t w = s->img[0], h = s->img[1];
+	if (dx >= w || -dx >= w || dy >= h || -dy >= h) return;
+	int32_t i0 = max(-dx, 0);
+	int32_t n = w - (dx < 0 ? -dx : dx);
+	int32_t j0 = max(-dy, 0), j1 = min(h - dy, h) - 1;
+
+	// New row j comes from old row j + dy, the order keeps sources unread rows
+	for (int32_t k = 0; k <= j1 - j0; k++) {
+		int32_t j = (dy > 0) ? j0 + k : j1 - k;
+		memmove(&s->back[j * w + i0], &s->back[(j + dy) * w + i0 + dx], n * sizeof(uint16_t));
+	}
+}
+
+/**
+ * Sets up a sprite, hidden
+ * @s: sprite
+ * @img: picture of img_buffer.h format, must stay valid
+ * @back: buffer of width * height pixels for the background, must stay valid
+ * @return: TFT_EOK if success or TFT_EWRONGARG if wrong arguments
+ */
+tft_err tft_sprite_init(tft_sprite *s, const uint16_t *img, uint16_t *back)
+{
+	if (s == NULL || img == NULL || back == NULL || img[0] == 0 || img[1] == 0) {
+		return TFT_EWRONGARG;
+	}
+	s->img = img;
+	s->mask = NULL;
+	s->fmt = TFT_ALPHA_A8;
+	s->keyed = false;
+	s->key = 0;
+	s->back = back;
+	s->x = 0;
+	s->y = 0;
+	s->shown = false;
+	return TFT_EOK;
+}
+
+/**
+ * Sets transparent color of the sprite
+ * @s: sprite
+ * @keyed: true if pixels of the key color are transparent
+ * @key: transparent color
+ *
+ * Note: takes effect on the next move.
+ */
+void tft_sprite_set_key(tft_sprite *s, bool keyed, uint16_t key)
+{
+	s->keyed = keyed;
+	s->key = key;
+}
+
+/**
+ * Sets alpha mask of the sprite
+ * @s: sprite
+ * @mask: alpha of every pixel or NULL for an opaque sprite
+ * @fmt: format of the mask
+ *
+ * Note: takes effect on the next move.
+ */
+void tft_sprite_set_mask(tft_sprite *s, const uint8_t *mask, enum tft_alpha_fmt fmt)
+{
+	s->mask = mask;
+	s->fmt = fmt;
+}
+
+/**
+ * Saves the background and draws the sprite
+ * @s: sprite
+ * @x: screen coordinate x of the top left corner, may be off the screen
+ * @y: screen coordinate y of the top left corner, may be off the screen
+ * @return: TFT_EOK if success or the error of tft_read_pixels(), e.g.
+ *          TFT_EUNAVAILABLE while recording a display list
+ *
+ * Note: a shown sprite is moved.
+ */
+tft_err tft_sprite_show(tft_sprite *s, int16_t x, int16_t y)
+{
+	tft_rect r;
+
+	if (s->shown) return tft_sprite_move(s, x, y);
+	s->x = x;
+	s->y = y;
+	if (sprite_rect(s, x, y, &r)) {
+		tft_err err = sprite_save(s, &r);
+		if (err) return err;
+		sprite_draw(s, &r);
+	}
+	s->shown = true;
+	return TFT_EOK;
+}
+
+/**
+ * Moves the sprite
+ * @s: sprite
+ * @x: new screen coordinate x of the top left corner
+ * @y: new screen coordinate y of the top left corner
+ * @return: TFT_EOK if success or the error of tft_read_pixels(), the sprite is hidden
+ *          then
+ *
+ * Note: if the places overlap, only the uncovered part of the old place is restored
+ * and only the newly covered part is read back. A hidden sprite is shown.
+ */
+tft_err tft_sprite_move(tft_sprite *s, int16_t x, int16_t y)
+{
+	tft_rect a, b, o, d[4];
+	uint8_t n;
+
+	if (!s->shown) return tft_sprite_show(s, x, y);
+	if (x == s->x && y == s->y) return TFT_EOK;
+	bool va = sprite_rect(s, s->x, s->y, &a);
+	bool vb = sprite_rect(s, x, y, &b);
+	o.x1 = max(a.x1, b.x1);
+	o.y1 = max(a.y1, b.y1);
+	o.x2 = min(a.x2, b.x2);
+	o.y2 = min(a.y2, b.y2);
+	if (!va || !vb || o.x1 > o.x2 || o.y1 > o.y2) {
+		tft_sprite_hide(s);
+		return tft_sprite_show(s, x, y);
+	}
+
+	n = rect_sub(&a, &o, d);					// Old place the sprite leaves
+	for (uint8_t i = 0; i < n; i++) sprite_restore(s, &d[i]);
+	sprite_shift(s, x - s->x, y - s->y);
+	s->x = x;
+	s->y = y;
+	n = rect_sub(&b, &o, d);					// New place not saved yet
+	for (uint8_t i = 0; i < n; i++) {
+		tft_err err = sprite_save(s, &d[i]);
+		if (err) {
+			// Only the overlap still shows the sprite, its background is saved already
+			sprite_restore(s, &o);
+			s->shown = false;
+			return err;
+		}
+	}
+	sprite_draw(s, &b);
+	return TFT_EOK;
+}
+
+/**
+ * Hides the sprite, its background is restored
+ * @s: sprite
+ * @return: TFT_EOK if success or TFT_EEMPTY if the sprite is not shown
+ */
+tft_err tft_sprite_hide(tft_sprite *s)
+{
+	tft_rect r;
+
+	if (!s->shown) return TFT_EEMPTY;
+	if (sprite_rect(s, s->x, s->y, &r)) sprite_restore(s, &r);
+	s->shown = false;
+	return TFT_EOK;
+}
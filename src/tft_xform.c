@@ -0,0 +1,207 @@
+/*Copyright (c) 2020 Oleksandr Ivanov.
+  *
+  * This software component is licensed under MIT license.
+  * You may not use this file except in compliance retain the
+  * above copyright notice.
+  */
+
+#include "tft_xform.h"
+#include "tft_blend.h"
+#include "ili9325.h"
+#include "macro.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <math.h>
+
+/**
+ *                                SCALED AND ROTATED PICTURES
+ * Picture coordinates u, v are 16.16 fixed point, pixel i covers [i, i + 1). A screen
+ * pixel center is mapped back to u, v, nearest sampling takes pixel (u, v), bilinear
+ * sampling weights the 4 pixels around (u - 1/2, v - 1/2) by 1/32 steps.
+ * Along a screen row u and v change by constant steps, so a row costs adds only.
+ */
+
+/*Part of a picture being sampled (private)*/
+typedef struct {
+	const uint16_t *px;			// First pixel of the part
+	uint16_t stride;			// Picture width
+	int32_t w, h;				// Part size
+	enum tft_filter filter;
+} xform_src;
+
+/**
+ * Gets part of a picture (private)
+ * @return: TFT_EOK if success or TFT_EWRONGARG if the part is out of the picture
+ */
+static tft_err xform_src_init(xform_src *s, const uint16_t *img, const tft_rect *src,
+		                      enum tft_filter filter)
+{
+	uint16_t width = img[0];
+	uint16_t height = img[1];
+	tft_rect r = {0, 0, width - 1, height - 1};
+
+	if (width == 0 || height == 0) return TFT_EWRONGARG;
+	if (src != NULL) {
+		if (src->x1 > src->x2 || src->y1 > src->y2 || src->x2 >= width || src->y2 >= height) {
+			return TFT_EWRONGARG;
+		}
+		r = *src;
+	}
+	s->px = &img[2] + (uint32_t)r.y1 * width + r.x1;	// Pixel colors follow the 2 words of sizes
+	s->stride = width;
+	s->w = r.x2 - r.x1 + 1;
+	s->h = r.y2 - r.y1 + 1;
+	s->filter = filter;
+	return TFT_EOK;
+}
+
+/**
+ * Samples the picture at u, v inside the part (private)
+ */
+static inline uint16_t xform_sample(const xform_src *s, int32_t u, int32_t v)
+{
+	if (s->filter == TFT_FILTER_NEAREST) {
+		return s->px[(v >> 16) * s->stride + (u >> 16)];
+	}
+	// Centers of the 4 pixels around, clamped to the part
+	u = min(max(u - 0x8000, 0), (s->w - 1) << 16);
+	v = min(max(v - 0x8000, 0), (s->h - 1) << 16);
+	int32_t x = u >> 16, y = v >> 16;
+	uint32_t fx = (u >> 11) & 31, fy = (v >> 11) & 31;
+	const uint16_t *p = &s->px[y * s->stride + x];
+	int32_t dx = (x + 1 < s->w) ? 1 : 0;
+	int32_t dy = (y + 1 < s->h) ? s->stride : 0;
+
+	uint32_t top = ((tft_rgb_spread(p[dx]) * fx + tft_rgb_spread(p[0]) * (32 - fx)) >> 5)
+			       & TFT_RGB_SPREAD_MASK;
+	uint32_t bot = ((tft_rgb_spread(p[dy + dx]) * fx + tft_rgb_spread(p[dy]) * (32 - fx)) >> 5)
+			       & TFT_RGB_SPREAD_MASK;
+	return tft_rgb_pack((bot * fy + top * (32 - fy)) >> 5);
+}
+
+/**
+ * Sends n samples stepping from u, v into the current frame, a burst per chunk (private)
+ * @u, @v: first sample, advanced past the last one
+ * @du, @dv: step between samples
+ * @n: amount of samples
+ */
+static void xform_span(const xform_src *s, int32_t *u, int32_t *v, int32_t du, int32_t dv,
+		               uint16_t n)
+{
+	uint16_t buf[TFT_XFORM_CHUNK];
+
+	while (n != 0) {
+		uint16_t k = min(n, (uint16_t)TFT_XFORM_CHUNK);
+		for (uint16_t i = 0; i < k; i++, *u += du, *v += dv) {
+			buf[i] = xform_sample(s, *u, *v);
+		}
+		tft_write_pixels(buf, k);
+		n -= k;
+	}
+}
+
+/**
+ * Drawing part of a picture scaled to a size
+ * @dst_x: screen coordinate x, may be negative
+ * @dst_y: screen coordinate y, may be negative
+ * @dst_w: width on the screen
+ * @dst_h: height on the screen
+ * @img: image data array of 16 bit words as for tft_pic_from_flash()
+ * @src: part of the image, NULL for the whole image
+ * @filter: TFT_FILTER_NEAREST or TFT_FILTER_BILINEAR
+ * @return: TFT_EOK if success, TFT_EWRONGARG if src is out of the image or
+ *          TFT_ERANGE if nothing is visible
+ *
+ * Note: the visible part is one frame, every row is generated and sent as bursts.
+ */
+tft_err tft_blit_scaled(int16_t dst_x, int16_t dst_y, uint16_t dst_w, uint16_t dst_h,
+		                const uint16_t *img, const tft_rect *src, enum tft_filter filter)
+{
+	xform_src s;
+	tft_rect c;
+
+	if (xform_src_init(&s, img, src, filter)) return TFT_EWRONGARG;
+	if (dst_w == 0 || dst_h == 0 || !tft_get_clip(&c)) return TFT_ERANGE;
+	int32_t x1 = max((int32_t)dst_x, (int32_t)c.x1), y1 = max((int32_t)dst_y, (int32_t)c.y1);
+	int32_t x2 = min((int32_t)dst_x + dst_w - 1, (int32_t)c.x2);
+	int32_t y2 = min((int32_t)dst_y + dst_h - 1, (int32_t)c.y2);
+	if (x1 > x2 || y1 > y2) return TFT_ERANGE;
+	if (tft_set_frame(x1, y1, x2, y2)) return TFT_ERANGE;
+
+	int32_t du = (s.w << 16) / dst_w;
+	int32_t dv = (s.h << 16) / dst_h;
+	int32_t u0 = du / 2 + du * (x1 - dst_x);			// Center of the first visible pixel
+	int32_t v = dv / 2 + dv * (y1 - dst_y);
+	for (int32_t y = y1; y <= y2; y++, v += dv) {
+		int32_t u = u0, vv = v;
+		xform_span(&s, &u, &vv, du, 0, x2 - x1 + 1);
+	}
+	return TFT_EOK;
+}
+
+/**
+ * Drawing part of a picture rotated and scaled around its center
+ * @cx: screen coordinate x of the picture center
+ * @cy: screen coordinate y of the picture center
+ * @img: image data array of 16 bit words as for tft_pic_from_flash()
+ * @src: part of the image, NULL for the whole image
+ * @angle: clockwise rotation in degrees
+ * @scale: size factor, 8.8 fixed point (256 is 1:1)
+ * @filter: TFT_FILTER_NEAREST or TFT_FILTER_BILINEAR
+ * @return: TFT_EOK if success, TFT_EWRONGARG if src is out of the image or scale is 0
+ *          or TFT_ERANGE if nothing is visible
+ *
+ * Note: only pixels covered by the picture are drawn, each row of the rotated
+ * picture is one frame and a burst.
+ */
+tft_err tft_blit_rotated(int16_t cx, int16_t cy, const uint16_t *img, const tft_rect *src,
+		                 int16_t angle, uint16_t scale, enum tft_filter filter)
+{
+	xform_src s;
+	tft_rect c;
+	bool drawn = false;
+
+	if (scale == 0 || xform_src_init(&s, img, src, filter)) return TFT_EWRONGARG;
+	float rad = angle * (float)M_PI / 180.0f;
+	float cs = cosf(rad), sn = sinf(rad);
+	// Screen steps of u, v: the inverse rotation divided by the scale
+	int32_t du_x = (int32_t)lroundf(cs * 65536.0f * 256.0f / scale);
+	int32_t dv_x = (int32_t)lroundf(-sn * 65536.0f * 256.0f / scale);
+	int32_t du_y = -dv_x, dv_y = du_x;
+
+	// Bounding box of the rotated picture
+	float k = scale / 512.0f;
+	int32_t hw = (int32_t)ceilf((fabsf(cs) * s.w + fabsf(sn) * s.h) * k) + 1;
+	int32_t hh = (int32_t)ceilf((fabsf(sn) * s.w + fabsf(cs) * s.h) * k) + 1;
+	if (!tft_get_clip(&c)) return TFT_ERANGE;
+	int32_t x1 = max(cx - hw, (int32_t)c.x1), y1 = max(cy - hh, (int32_t)c.y1);
+	int32_t x2 = min(cx + hw, (int32_t)c.x2), y2 = min(cy + hh, (int32_t)c.y2);
+	if (x1 > x2 || y1 > y2) return TFT_ERANGE;
+
+	// u, v of the center of pixel (x1, y1), x1 and y1 are inside the bounding box now
+	int32_t ox = 2 * (x1 - cx) + 1, oy = 2 * (y1 - cy) + 1;		// Doubled to keep halves
+	int32_t u_row = (s.w << 15) + (int32_t)(((int64_t)du_x * ox + (int64_t)du_y * oy) / 2);
+	int32_t v_row = (s.h << 15) + (int32_t)(((int64_t)dv_x * ox + (int64_t)dv_y * oy) / 2);
+
+	for (int32_t y = y1; y <= y2; y++, u_row += du_y, v_row += dv_y) {
+		// Picture covers one interval of the row, find its ends
+		int32_t first = x1, last = x2;
+		int32_t u = u_row, v = v_row;
+		while (first <= x2 && (u < 0 || v < 0 || (u >> 16) >= s.w || (v >> 16) >= s.h)) {
+			first++;
+			u += du_x;
+			v += dv_x;
+		}
+		if (first > x2) continue;
+		int32_t ue = u_row + du_x * (x2 - x1), ve = v_row + dv_x * (x2 - x1);
+		while (ue < 0 || ve < 0 || (ue >> 16) >= s.w || (ve >> 16) >= s.h) {
+			last--;
+			ue -= du_x;
+			ve -= dv_x;
+		}
+		if (tft_set_frame(first, y, last, y)) continue;
+		xform_span(&s, &u, &v, du_x, dv_x, last - first + 1);
+		drawn = true;
+	}
+	return drawn ? TFT_EOK : TFT_ERANGE;
+}
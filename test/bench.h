@@ -0,0 +1,26 @@
+#pragma once
+
+#include "test.h"
+
+/**
+ * Host benchmark output.
+ *
+ * Costs are counted by the doubles, not timed: register stores of the driver, bus
+ * strobes, frames (GRAM accesses opened with R22h), register writes and pixels written
+ * to the panel, then stores and strobes per pixel.
+ */
+
+static inline double bench_per_pixel(uint32_t count)
+{
+	return host_panel_stats.pixels ? (double)count / host_panel_stats.pixels : 0.0;
+}
+
+#define BENCH_HEADER() \
+	printf("%-40s %9s %9s %7s %7s %8s %7s %7s\n", \
+	       "case", "stores", "strobes", "frames", "regs", "pixels", "st/px", "sb/px")
+
+#define BENCH_ROW(name) \
+	printf("%-40s %9u %9u %7u %7u %8u %7.2f %7.2f\n", (name), host_bus_stats.stores, \
+	       host_bus_stats.strobes, host_panel_stats.frames, host_panel_stats.regs, \
+	       host_panel_stats.pixels, bench_per_pixel(host_bus_stats.stores), \
+	       bench_per_pixel(host_bus_stats.strobes))
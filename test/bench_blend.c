@@ -0,0 +1,93 @@
+/*
+ * Cost of alpha blending.
+ * Bus: blended primitives read the background back, so they pay RD strobes and a read
+ * frame per chunk on top of the write; the same fills in a band pass pay no reads.
+ * Kernel: host time per pixel of the spread blend against the per channel reference,
+ * host ratios only, the target cycles depend on the core.
+ */
+
+#include "bench.h"
+#include "tft.h"
+#include "tft_blend.h"
+#include "tft_band.h"
+#include <time.h>
+
+#define KERNEL_PIXELS	(64 * 1024)
+#define KERNEL_ROUNDS	64
+
+static uint16_t fg[KERNEL_PIXELS], bg[KERNEL_PIXELS], out[KERNEL_PIXELS];
+static uint8_t mask[100 * 100];
+
+/*Per channel blend as in test_blend.c*/
+static __attribute__((noinline)) uint16_t ref_blend(uint16_t f, uint16_t b, uint8_t alpha)
+{
+	uint32_t w = (alpha + 4) >> 3;
+	uint32_t r = ((f >> 11) * w + (b >> 11) * (32 - w)) >> 5;
+	uint32_t g = (((f >> 5) & 0x3F) * w + ((b >> 5) & 0x3F) * (32 - w)) >> 5;
+	uint32_t bl = ((f & 0x1F) * w + (b & 0x1F) * (32 - w)) >> 5;
+	return (uint16_t)(r << 11 | g << 5 | bl);
+}
+
+static double now_ns(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static void kernel_row(const char *name, uint16_t (*blend)(uint16_t, uint16_t, uint8_t))
+{
+	double t0 = now_ns();
+	for (uint32_t r = 0; r < KERNEL_ROUNDS; r++) {
+		for (uint32_t i = 0; i < KERNEL_PIXELS; i++) out[i] = blend(fg[i], bg[i], (uint8_t)(i + r));
+	}
+	double ns = (now_ns() - t0) / ((double)KERNEL_ROUNDS * KERNEL_PIXELS);
+	printf("%-40s %7.2f ns/px (host)\n", name, ns);
+}
+
+static void row(const char *name)
+{
+	BENCH_ROW(name);
+	printf("%-40s RD strobes %u\n", "", host_bus_stats.reads);
+}
+
+static void draw_blend(void *ctx)
+{
+	(void)ctx;
+	tft_fill_rect_blend(60, 40, 100, 100, 0xF800, 128);
+}
+
+int main(void)
+{
+	for (uint32_t i = 0; i < KERNEL_PIXELS; i++) {
+		fg[i] = (uint16_t)(i * 0x9E37);
+		bg[i] = (uint16_t)(i * 0x3B5 + 7);
+	}
+	for (uint32_t i = 0; i < sizeof(mask); i++) mask[i] = (uint8_t)(i * 37);
+
+	printf("bench_blend: GPIO bus, 320x240\n");
+	BENCH_HEADER();
+	host_tft_init();
+	tft_fill_rectangle(60, 40, 100, 100, 0xF800);
+	row("opaque fill_rectangle 100x100");
+	host_tft_init();
+	tft_fill_rect_blend(60, 40, 100, 100, 0xF800, 128);
+	row("fill_rect_blend 100x100");
+	host_tft_init();
+	tft_fill_rect_blend(60, 40, 8, 100, 0xF800, 128);
+	row("fill_rect_blend 8x100");
+	host_tft_init();
+	tft_fill_mask_blend(60, 40, 100, 100, mask, TFT_ALPHA_A8, 0xF800, 255);
+	row("fill_mask_blend A8 100x100");
+	host_tft_init();
+	tft_set_font(COURIER_NEW_12_BOLD, 0xFFFF, 0x0000);
+	tft_print_str_blend(0, 100, "Translucent text", 160);
+	row("print_str_blend 16 chars");
+	host_tft_init();
+	tft_band_render(draw_blend, NULL);
+	row("band fill_rect_blend 100x100");
+
+	kernel_row("kernel spread tft_blend_color", tft_blend_color);
+	kernel_row("kernel per channel reference", ref_blend);
+	return 0;
+}
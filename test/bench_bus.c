@@ -0,0 +1,48 @@
+/*
+ * Bus cost per pixel of the ili9325 pixel functions.
+ * Pixel runs in a burst are one data store and two WR stores per pixel, fills two WR
+ * stores; single pixels pay the command and register writes around them.
+ */
+
+#include "bench.h"
+#include "tft.h"
+#include "ili9325.h"
+
+static uint16_t line[320];
+
+int main(void)
+{
+	for (int i = 0; i < 320; i++) line[i] = (uint16_t)(i * 0x0841);
+	printf("bench_bus: GPIO bus, 320x240\n");
+	BENCH_HEADER();
+
+	host_tft_init();
+	for (int y = 0; y < 240; y++) {
+		tft_set_frame(0, y, 319, y);
+		tft_write_pixels(line, 320);
+	}
+	BENCH_ROW("write_pixels 320x240");
+
+	host_tft_init();
+	tft_fill_screen(0xFFFF);
+	BENCH_ROW("fill_screen");
+
+	host_tft_init();
+	tft_set_frame(0, 0, 319, 239);
+	ili9325_write_pixels_begin();
+	for (uint32_t i = 0; i < 320UL * 240; i++) tft_frame_draw_pixel(line[i % 320]);
+	ili9325_write_pixels_end();
+	BENCH_ROW("frame_draw_pixel in burst");
+
+	host_tft_init();
+	tft_set_frame(0, 0, 319, 239);
+	for (uint32_t i = 0; i < 320UL * 240; i++) tft_frame_draw_pixel(line[i % 320]);
+	BENCH_ROW("frame_draw_pixel no burst");
+
+	host_tft_init();
+	for (int y = 0; y < 240; y += 8) {
+		for (int x = 0; x < 320; x++) ili9325_draw_pixel(x, y, line[x]);
+	}
+	BENCH_ROW("draw_pixel along rows");
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Display list encoding size and replay cost against drawing the same scene directly.
+ * Encoding is the arena used: commands (16 bytes on the target, 24 with host pointers)
+ * plus copied pixels. Host images are not in the internal flash range, so they are
+ * copied like SRAM pixels on the target.
+ * Replay must leave GRAM exactly as the direct drawing did.
+ */
+
+#include "bench.h"
+#include "tft.h"
+#include "tft_dl.h"
+#include <string.h>
+
+/*Icon with the 2 words of sizes in front of the pixels*/
+#define ICON_SIZE	48
+static uint16_t icon[2 + ICON_SIZE * ICON_SIZE];
+
+/*Arena and GRAM of the direct drawing*/
+static uint32_t arena[96 * 1024];
+static uint16_t direct[320][240];
+
+static void scene_dashboard(void)
+{
+	tft_fill_rectangle(0, 0, 320, 24, 0x001F);
+	tft_fill_rectangle(0, 24, 320, 216, 0x0000);
+	tft_set_font(COURIER_NEW_12_BOLD, 0xFFFF, 0x001F);
+	tft_print_str(4, 4, "Dashboard");
+	for (uint16_t i = 0; i < 4; i++) {
+		tft_fill_round_rect(8 + i * 78, 40, 70, 60, 8, 0x4208);
+		tft_fill_rectangle(16 + i * 78, 80, 54, 8, 0x07E0);
+	}
+	tft_fill_circle(80, 170, 40, 0xF800);
+	tft_fill_circle(240, 170, 40, 0xFFE0);
+	tft_draw_rectangle(4, 116, 312, 120, 1, 0xFFFF);
+}
+
+static void scene_text(void)
+{
+	tft_fill_rectangle(0, 0, 320, 240, 0x0000);
+	tft_set_font(COURIER_NEW_8_NORM, 0xFFFF, 0x0000);
+	for (uint16_t y = 0; y + 10 <= 240; y += 12) {
+		tft_print_str(0, y, "The quick brown fox jumps over");
+	}
+}
+
+static void scene_icons(void)
+{
+	tft_fill_rectangle(0, 0, 320, 240, 0x8410);
+	for (uint16_t y = 8; y + ICON_SIZE <= 240; y += ICON_SIZE + 8) {
+		for (uint16_t x = 8; x + ICON_SIZE <= 320; x += ICON_SIZE + 8) {
+			tft_blit(x, y, icon, NULL);
+		}
+	}
+}
+
+static const struct {
+	const char *name;
+	void (*draw)(void);
+} scenes[] = {
+	{"dashboard", scene_dashboard},
+	{"text", scene_text},
+	{"icons", scene_icons},
+};
+
+int main(void)
+{
+	char name[64];
+	tft_dl dl;
+
+	icon[0] = icon[1] = ICON_SIZE;
+	for (uint32_t i = 0; i < ICON_SIZE * ICON_SIZE; i++) icon[2 + i] = (uint16_t)(i * 0x0841);
+
+	printf("bench_dl: GPIO bus, 320x240\n");
+	BENCH_HEADER();
+	for (uint32_t i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+		host_tft_init();
+		scenes[i].draw();
+		snprintf(name, sizeof(name), "direct %s", scenes[i].name);
+		BENCH_ROW(name);
+		memcpy(direct, host_panel_gram, sizeof(direct));
+
+		host_tft_init();
+		tft_dl_begin(&dl, arena, sizeof(arena));
+		scenes[i].draw();
+		tft_err err = tft_dl_end(&dl);
+		uint32_t recorded = host_bus_stats.stores;
+		uint32_t cmd_bytes = dl.n * sizeof(tft_dl_cmd);
+		uint32_t pixel_bytes = (uint32_t)((uint8_t *)arena + sizeof(arena) - (uint8_t *)dl.data);
+
+		host_stats_reset();
+		tft_dl_submit(&dl);
+		snprintf(name, sizeof(name), "replay %s", scenes[i].name);
+		BENCH_ROW(name);
+		printf("%-40s %s, %u commands (%u B) + %u B pixels, %u stores recording, GRAM %s\n",
+		       "", err ? "overflow" : "encoded", dl.n, cmd_bytes, pixel_bytes, recorded,
+		       memcmp(direct, host_panel_gram, sizeof(direct)) ? "differs" : "matches");
+	}
+	return 0;
+}
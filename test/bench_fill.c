@@ -0,0 +1,81 @@
+/*
+ * Bus cost of the span fills against the baseline circle fill.
+ * The baseline drew two vertical lines per midpoint step with a frame per pixel
+ * (baseline tft_draw_line() and tft_draw_point()), rows near the poles were drawn again
+ * by following steps. Covered pixels show the overdraw.
+ */
+
+#include "bench.h"
+#include "tft.h"
+
+/*Baseline tft_draw_point() of size 1*/
+static void legacy_draw_point(uint16_t w, uint16_t h, uint16_t color)
+{
+	if (w + 1 >= 320 || h + 1 >= 240) return;
+	if (tft_set_frame(w, h, w, h)) return;
+	tft_frame_draw_pixel(color);
+}
+
+/*Baseline tft_draw_line() of a vertical line, y1 <= y2*/
+static void legacy_draw_v_line(uint16_t x, uint16_t y1, uint16_t y2, uint16_t color)
+{
+	for (uint16_t y = y1; y <= y2; y++) legacy_draw_point(x, y, color);
+}
+
+/*Baseline tft_fill_circle()*/
+static void legacy_fill_circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t color)
+{
+	int x = -radius, y = 0, err = 2 - 2 * radius, e2;
+	do {
+		legacy_draw_v_line(x0 - x, y0 - y, y0 + y, color);
+		legacy_draw_v_line(x0 + x, y0 - y, y0 + y, color);
+		e2 = err;
+		if (e2 <= y) {
+			err += ++y * 2 + 1;
+			if (-x == y && e2 <= x) e2 = 0;
+		}
+		if (e2 > x) err += ++x * 2 + 1;
+	} while (x <= 0);
+}
+
+/*Pixels of the screen that are not black*/
+static uint32_t covered(void)
+{
+	uint32_t n = 0;
+	for (uint16_t y = 0; y < 240; y++) {
+		for (uint16_t x = 0; x < 320; x++) n += host_panel_pixel(x, y) != 0;
+	}
+	return n;
+}
+
+static void row(const char *name)
+{
+	uint32_t n = covered();
+	BENCH_ROW(name);
+	printf("%-40s covered %u, overdraw %u\n", "", n, host_panel_stats.pixels - n);
+}
+
+int main(void)
+{
+	static const uint16_t radii[] = {10, 30, 100};
+	char name[64];
+	printf("bench_fill: GPIO bus, 320x240\n");
+	BENCH_HEADER();
+	for (uint32_t i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+		host_tft_init();
+		legacy_fill_circle(160, 120, radii[i], 0xF800);
+		snprintf(name, sizeof(name), "baseline fill_circle r=%u", radii[i]);
+		row(name);
+		host_tft_init();
+		tft_fill_circle(160, 120, radii[i], 0xF800);
+		snprintf(name, sizeof(name), "spans    fill_circle r=%u", radii[i]);
+		row(name);
+	}
+	host_tft_init();
+	tft_fill_ellipse(160, 120, 100, 40, 0xF800);
+	row("spans    fill_ellipse 100x40");
+	host_tft_init();
+	tft_fill_round_rect(60, 60, 200, 120, 20, 0xF800);
+	row("spans    fill_round_rect 200x120 r=20");
+	return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * Glyph rendering speed of every font against the baseline renderer, which tested the
+ * font bits one by one (tft_print_char() before the nibble table).
+ * Characters per second are timed on the host with the pixel functions swapped for a
+ * sink, so only building the rows is measured; host ratios only, the target speed
+ * depends on the core and the bus. Both renderers send the same rows, the sink hash
+ * shows it. Bus costs of one line of text follow, they are the same for both.
+ */
+
+#include "bench.h"
+#include "tft.h"
+#include "fonts.h"
+#include <time.h>
+
+#define ROUNDS		2000
+
+/*Printable ASCII symbols*/
+#define ASCII_CHARS	" !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`" \
+					"abcdefghijklmnopqrstuvwxyz{|}~"
+
+static const struct {
+	const char *name;
+	uint8_t type;
+	const char *chars;		// Symbols of the font
+} fonts[] = {
+	{"COURIER_NEW_8_BOLD", COURIER_NEW_8_BOLD, ASCII_CHARS},
+	{"COURIER_NEW_12_BOLD", COURIER_NEW_12_BOLD, ASCII_CHARS},
+	{"COURIER_NEW_8_NORM", COURIER_NEW_8_NORM, ASCII_CHARS},
+	{"COURIER_NEW_20_NORM", COURIER_NEW_20_NORM, ASCII_CHARS},
+	{"UBUNTUMONO_14_NORM", UBUNTUMONO_14_NORM, ASCII_CHARS},
+	{"SEVEN_SEGMENT", SEVEN_SEGMENT, "0123456789"},
+	{"UBUNTU_14_PROP", UBUNTU_14_PROP, ASCII_CHARS},
+};
+
+/*Hash of the pixels sent to the sink*/
+static uint32_t sink_hash;
+
+static tft_err sink_set_frame(uint16_t w1, uint16_t h1, uint16_t w2, uint16_t h2)
+{
+	sink_hash = sink_hash * 31 + (w1 ^ h1 << 4 ^ w2 << 8 ^ h2 << 12);
+	return TFT_EOK;
+}
+
+static void sink_write_pixels(const uint16_t *src, uint32_t n)
+{
+	while (n--) sink_hash = sink_hash * 31 + *src++;
+}
+
+static void sink_fill_pixels(uint16_t color, uint32_t n)
+{
+	while (n--) sink_hash = sink_hash * 31 + color;
+}
+
+static void sink_fill_screen(uint16_t color)
+{
+	sink_fill_pixels(color, 320UL * 240);
+}
+
+static void sink_frame_draw_pixel(uint16_t color)
+{
+	sink_fill_pixels(color, 1);
+}
+
+static tft_err sink_read_pixels(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *dst)
+{
+	(void)x; (void)y; (void)w; (void)h; (void)dst;
+	return TFT_EUNAVAILABLE;
+}
+
+static tft_err sink_fill_pixels_async(uint16_t color, uint32_t n, void (*done)(void))
+{
+	sink_fill_pixels(color, n);
+	if (done != NULL) done();
+	return TFT_EOK;
+}
+
+static tft_err sink_write_pixels_async(const uint16_t *src, uint32_t n, void (*done)(void))
+{
+	sink_write_pixels(src, n);
+	if (done != NULL) done();
+	return TFT_EOK;
+}
+
+static void sink_wait_idle(void)
+{
+}
+
+static const tft_pixel_ops sink = {
+	.set_frame = sink_set_frame,
+	.fill_screen = sink_fill_screen,
+	.frame_draw_pixel = sink_frame_draw_pixel,
+	.write_pixels = sink_write_pixels,
+	.fill_pixels = sink_fill_pixels,
+	.read_pixels = sink_read_pixels,
+	.fill_pixels_async = sink_fill_pixels_async,
+	.write_pixels_async = sink_write_pixels_async,
+	.wait_idle = sink_wait_idle
+};
+
+/*Baseline tft_print_char(): cell rows built bit by bit, a row per burst*/
+static tft_err legacy_print_char(uint16_t x, uint16_t y, uint16_t ascii)
+{
+	tft_glyph g;
+	uint8_t temp;
+
+	tft_font_get_glyph(ascii, &g);
+	uint16_t row[g.advance];
+	if (tft_set_frame(x, y, x + g.advance - 1, y + font_height - 1)) return TFT_ERANGE;
+	for (int32_t j = -g.y; j < font_height - g.y; j++) {
+		uint16_t *px = row;
+		for (uint16_t i = 0; i < g.advance; i++) {
+			if (j < 0 || j >= g.height || i < g.x || i >= g.x + g.width) {
+				*px++ = font_back_color;
+				continue;
+			}
+			temp = g.bits[j * ((g.width + 7) / 8) + (i - g.x) / 8] << ((i - g.x) & 7);
+			if (temp & 0x80) {
+				*px++ = font_color;
+			}
+			else {
+				*px++ = font_back_color;
+			}
+		}
+		tft_write_pixels(row, g.advance);
+	}
+	return TFT_EOK;
+}
+
+static double now_ns(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/*Prints the symbols ROUNDS times, returns chars per second*/
+static double chars_per_s(tft_err (*print)(uint16_t, uint16_t, uint16_t), const char *chars)
+{
+	uint32_t n = 0;
+	double t0 = now_ns();
+	for (uint32_t r = 0; r < ROUNDS; r++) {
+		uint16_t x = 0;
+		for (const char *c = chars; *c != 0; c++, n++) {
+			uint16_t adv = tft_char_advance(*c, 0);
+			if (x + adv > 320) x = 0;
+			print(x, 0, *c);
+			x += adv;
+		}
+	}
+	return n / ((now_ns() - t0) * 1e-9);
+}
+
+int main(void)
+{
+	tft_pixel_ops panel;
+
+	printf("bench_glyph: host chars/s with a pixel sink\n");
+	printf("%-40s %12s %12s %7s %s\n", "font", "baseline", "table", "ratio", "rows");
+	host_tft_init();
+	tft_get_pixel_ops(&panel);
+	tft_set_pixel_ops(&sink);
+	for (uint32_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+		tft_set_font(fonts[i].type, 0xFFFF, 0x001F);
+		sink_hash = 0;
+		double base = chars_per_s(legacy_print_char, fonts[i].chars);
+		uint32_t base_hash = sink_hash;
+		sink_hash = 0;
+		double table = chars_per_s(tft_print_char, fonts[i].chars);
+		printf("%-40s %12.0f %12.0f %7.2f %s\n", fonts[i].name, base, table, table / base,
+		       sink_hash == base_hash ? "same" : "differ");
+	}
+	tft_set_pixel_ops(&panel);
+
+	printf("\nbench_glyph: GPIO bus, 320x240, 20 symbols\n");
+	BENCH_HEADER();
+	for (uint32_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+		host_tft_init();
+		tft_set_font(fonts[i].type, 0xFFFF, 0x001F);
+		tft_print_str(0, 0, (fonts[i].type == SEVEN_SEGMENT) ? "01234567890123456789" :
+		              "The quick brown fox.");
+		BENCH_ROW(fonts[i].name);
+	}
+	return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * Bus cost of tft_draw_line() against the baseline per-pixel rasterizer.
+ * The baseline called tft_draw_point() for every Bresenham pixel, a frame per pixel.
+ * Its range check (w + size >= width) also dropped points touching the last column or
+ * row, so lines ending there had one pixel (pen square) less.
+ */
+
+#include "bench.h"
+#include "tft.h"
+#include <stdlib.h>
+
+/*Baseline tft_draw_point()*/
+static void legacy_draw_point(uint16_t w, uint16_t h, uint8_t size, uint16_t color)
+{
+	if (w + size >= 320 || h + size >= 240) return;
+	uint16_t i = (uint16_t)size * size;
+	if (tft_set_frame(w, h, w + size - 1, h + size - 1)) return;
+	while (i--) tft_frame_draw_pixel(color);
+}
+
+/*Baseline tft_draw_line()*/
+static void legacy_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t width,
+		                     uint16_t color)
+{
+	int deltaX = abs(x2 - x1);
+	int deltaY = abs(y2 - y1);
+	int signX = (x1 < x2) ? 1 : -1;
+	int signY = (y1 < y2) ? 1 : -1;
+	int error = deltaX - deltaY;
+
+	while (1) {
+		legacy_draw_point(x1, y1, width, color);
+		if (x1 == x2 && y1 == y2) return;
+		int error2 = error * 2;
+		if (error2 > -deltaY) {
+			error -= deltaY;
+			x1 += signX;
+		}
+		if (error2 < deltaX) {
+			error += deltaX;
+			y1 += signY;
+		}
+	}
+}
+
+static const struct {
+	const char *name;
+	uint16_t x1, y1, x2, y2;
+} lines[] = {
+	{"diagonal (0,0)-(239,239)", 0, 0, 239, 239},
+	{"diagonal (0,0)-(238,238)", 0, 0, 238, 238},
+	{"shallow (0,0)-(319,40)", 0, 0, 319, 40},
+	{"steep (0,0)-(40,239)", 0, 0, 40, 239},
+	{"horizontal (0,120)-(319,120)", 0, 120, 319, 120},
+	{"vertical (160,0)-(160,239)", 160, 0, 160, 239},
+};
+
+int main(void)
+{
+	char name[64];
+	printf("bench_line: GPIO bus, 320x240\n");
+	for (uint8_t width = 1; width <= 3; width += 2) {
+		BENCH_HEADER();
+		for (uint32_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+			host_tft_init();
+			legacy_draw_line(lines[i].x1, lines[i].y1, lines[i].x2, lines[i].y2, width, 0xF800);
+			snprintf(name, sizeof(name), "w%u baseline %s", width, lines[i].name);
+			BENCH_ROW(name);
+			host_tft_init();
+			tft_draw_line(lines[i].x1, lines[i].y1, lines[i].x2, lines[i].y2, width, 0xF800);
+			snprintf(name, sizeof(name), "w%u runs     %s", width, lines[i].name);
+			BENCH_ROW(name);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Host build of the ili9325 and tft libs.
+ *
+ * Force-included (-include) into every source of a host test. The bus registers of
+ * ili9325_bus.h are redirected to RAM and every access goes to the bus model of
+ * host_bus.c, which decodes the strobes and drives the panel model of host_panel.c.
+ * Built with -no-pie, so static buffers fit 32-bit DMA addresses as on the target.
+ */
+
+#include <stdint.h>
+
+/*GPIO ports A..K and FSMC bank registers in RAM*/
+extern uint32_t host_gpio[];
+extern uint16_t host_fsmc[];
+
+void host_bus_store(volatile void *reg, uint32_t value);
+uint32_t host_bus_load(volatile void *reg);
+
+#define BUS_STORE(reg, value)   host_bus_store(&(reg), (value))
+#define BUS_LOAD(reg)           host_bus_load(&(reg))
+#define BUS_GPIO_BASE(port)     ((uintptr_t)host_gpio + 0x400 * (port))
+#define ILI9325_FSMC_BASE       ((uintptr_t)host_fsmc)
@@ -0,0 +1,140 @@
+/*
+ * Host bus model, see host_bus.h
+ */
+
+#include "host_bus.h"
+#include "host_panel.h"
+#include "pin.h"
+#include <string.h>
+
+/*11 ports of 0x400 bytes, registers in RAM*/
+uint32_t host_gpio[11 * 0x100];
+/*Command at the base, data at A[RS_LINE] (HADDR bit RS_LINE + 1)*/
+uint16_t host_fsmc[(1UL << (ILI9325_FSMC_RS_LINE + 1)) / 2 + 1]
+	__attribute__((aligned(1UL << (ILI9325_FSMC_RS_LINE + 2))));
+
+struct host_bus_stats host_bus_stats;
+struct host_bus_event host_bus_log[HOST_BUS_LOG_LEN];
+uint32_t host_bus_log_len;
+
+static uint32_t gpio_reg(int port, int off)
+{
+	return host_gpio[(port * 0x400 + off) / 4];
+}
+
+/*Level of the control pin with CTRL_INVERSIONS applied*/
+static int ctrl_level(uint32_t odr, int pin)
+{
+	return ((odr >> pin) ^ (CTRL_INVERSIONS >> pin)) & 1;
+}
+
+static void log_event(int port, int off, bool load, uint32_t value)
+{
+	if (host_bus_log_len < HOST_BUS_LOG_LEN) {
+		host_bus_log[host_bus_log_len] = (struct host_bus_event){port, off, load, value};
+	}
+	host_bus_log_len++;
+}
+
+/**
+ * Decodes WR and RD edges of the control port
+ * @prev: control port output before the store
+ */
+static void ctrl_edges(uint32_t prev)
+{
+	uint32_t odr = gpio_reg(PORT_CTRL, HOST_BUS_ODR);
+	if (ctrl_level(odr, CS_PIN)) return;
+	bool output = gpio_reg(PORT_DATA, HOST_BUS_MODER) != 0;
+
+	if (!ctrl_level(prev, WR_PIN) && ctrl_level(odr, WR_PIN)) {
+		uint16_t data = (uint16_t)(gpio_reg(PORT_DATA, HOST_BUS_ODR) ^ DATA_INVERSIONS);
+		host_bus_stats.strobes++;
+		if (!output) host_bus_stats.faults++;
+		if (ctrl_level(odr, RS_PIN)) {
+			host_panel_write_data(data);
+		} else {
+			host_panel_write_cmd(data);
+		}
+	}
+	if (ctrl_level(prev, RD_PIN) && !ctrl_level(odr, RD_PIN)) {
+		host_bus_stats.reads++;
+		if (output) host_bus_stats.faults++;
+		host_gpio[(PORT_DATA * 0x400 + HOST_BUS_IDR) / 4] = host_panel_read() ^ DATA_INVERSIONS;
+	}
+}
+
+void host_bus_store(volatile void *reg, uint32_t value)
+{
+	uintptr_t addr = (uintptr_t)reg;
+	host_bus_stats.stores++;
+
+	if (addr >= (uintptr_t)host_fsmc && addr < (uintptr_t)host_fsmc + sizeof(host_fsmc)) {
+		int off = (int)(addr - (uintptr_t)host_fsmc);
+		log_event(HOST_BUS_FSMC, off ? HOST_BUS_FSMC_DATA : HOST_BUS_FSMC_CMD, false, value);
+		host_bus_stats.strobes++;
+		if (off) {
+			host_panel_write_data((uint16_t)value);
+		} else {
+			host_panel_write_cmd((uint16_t)value);
+		}
+		return;
+	}
+
+	int port = (int)((addr - (uintptr_t)host_gpio) / 0x400);
+	int off = (int)((addr - (uintptr_t)host_gpio) % 0x400);
+	uint32_t *odr = &host_gpio[(port * 0x400 + HOST_BUS_ODR) / 4];
+	uint32_t prev = *odr;
+	log_event(port, off, false, value);
+	switch (off) {
+	case HOST_BUS_BSRR:
+		*odr = (*odr & ~(value >> 16)) | (value & 0xFFFF);
+		break;
+	case HOST_BUS_ODR:
+		*odr = value & 0xFFFF;
+		break;
+	default:
+		*(volatile uint32_t *)reg = value;
+		break;
+	}
+	if (port == PORT_CTRL) ctrl_edges(prev);
+}
+
+uint32_t host_bus_load(volatile void *reg)
+{
+	uintptr_t addr = (uintptr_t)reg;
+	host_bus_stats.loads++;
+
+	if (addr >= (uintptr_t)host_fsmc && addr < (uintptr_t)host_fsmc + sizeof(host_fsmc)) {
+		uint16_t data = host_panel_read();
+		host_bus_stats.reads++;
+		log_event(HOST_BUS_FSMC, HOST_BUS_FSMC_DATA, true, data);
+		return data;
+	}
+	int port = (int)((addr - (uintptr_t)host_gpio) / 0x400);
+	int off = (int)((addr - (uintptr_t)host_gpio) % 0x400);
+	uint32_t value = *(volatile uint32_t *)reg;
+	log_event(port, off, true, value);
+	return value;
+}
+
+/**
+ * Releases the bus (control pins high, data port output) and clears statistics and log
+ */
+void host_bus_reset(void)
+{
+	memset(host_gpio, 0, sizeof(host_gpio));
+	host_gpio[(PORT_CTRL * 0x400 + HOST_BUS_ODR) / 4] =
+		((1 << RS_PIN) | (1 << WR_PIN) | (1 << CS_PIN) | (1 << RD_PIN) | (1 << RESET_PIN))
+		^ CTRL_INVERSIONS;
+	host_gpio[(PORT_DATA * 0x400 + HOST_BUS_MODER) / 4] = 0x55555555UL;
+	memset(&host_bus_stats, 0, sizeof(host_bus_stats));
+	host_bus_log_reset();
+}
+
+/**
+ * Clears the event log
+ */
+void host_bus_log_reset(void)
+{
+	host_bus_log_len = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Host bus model.
+ *
+ * Records the register stores and loads of ili9325_bus.h. GPIO bus: WR rising edges
+ * with CS low latch the data port into the panel as a command (RS low) or data, RD falling
+ * edges put the panel read data on the input register. FSMC bus: stores to the command
+ * and data addresses go to the panel directly.
+ */
+
+/*Port of FSMC events in the log, GPIO events carry the port number*/
+#define HOST_BUS_FSMC       0xFF
+/*Register offsets in the log*/
+#define HOST_BUS_MODER      0x00
+#define HOST_BUS_IDR        0x10
+#define HOST_BUS_ODR        0x14
+#define HOST_BUS_BSRR       0x18
+#define HOST_BUS_FSMC_CMD   0x00
+#define HOST_BUS_FSMC_DATA  0x02
+/*Amount of events kept in the log*/
+#define HOST_BUS_LOG_LEN    4096
+
+/*
+ * host_bus_event
+ * @port: GPIO port or HOST_BUS_FSMC
+ * @off: register offset
+ * @value: stored value, loaded value for loads
+ * @load: true for loads
+ */
+struct host_bus_event {
+	uint8_t port;
+	uint8_t off;
+	bool load;
+	uint32_t value;
+};
+
+/*
+ * host_bus_stats
+ * @stores: register stores
+ * @loads: register loads
+ * @strobes: bus writes, WR strobes on GPIO bus or stores on FSMC bus
+ * @reads: bus reads, RD strobes on GPIO bus or loads on FSMC bus
+ * @calls: libopencm3 gpio calls
+ * @faults: strobes with the data port in input mode or reads with it in output mode
+ */
+struct host_bus_stats {
+	uint32_t stores;
+	uint32_t loads;
+	uint32_t strobes;
+	uint32_t reads;
+	uint32_t calls;
+	uint32_t faults;
+};
+
+extern struct host_bus_stats host_bus_stats;
+extern struct host_bus_event host_bus_log[HOST_BUS_LOG_LEN];
+extern uint32_t host_bus_log_len;
+
+void host_bus_reset(void);
+void host_bus_log_reset(void);
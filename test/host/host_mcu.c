@@ -0,0 +1,333 @@
+/*
+ * Host doubles of libopencm3 and the core, see host_mcu.h
+ */
+
+#include "host_mcu.h"
+#include "host_bus.h"
+#include "intrinsics.h"
+#include "pin.h"
+#include <libopencm3/stm32/dma.h>
+#include <libopencm3/stm32/rcc.h>
+#include <libopencm3/cm3/nvic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if ILI9325_USE_DMA
+#define _DMA_ISR(n)     dma2_stream##n##_isr
+#define DMA_ISR(n)      _DMA_ISR(n)
+void DMA_ISR(ILI9325_DMA_STREAM)(void);
+#endif
+
+/*
+ * dma_stream
+ * @par: source (peripheral port in memory-to-memory mode)
+ * @mar: destination (memory port)
+ * @ndtr: items of the chunk
+ * @pinc, @minc: address increments
+ * @enabled: stream is running, the chunk is done on host_dma_run()
+ * @irq_mask: flags that raise the interrupt
+ * @flags: raised interrupt flags
+ */
+struct dma_stream {
+	uint32_t par;
+	uint32_t mar;
+	uint16_t ndtr;
+	bool pinc;
+	bool minc;
+	bool enabled;
+	uint32_t irq_mask;
+	uint32_t flags;
+};
+
+struct host_mcu_stats host_mcu_stats;
+
+static struct dma_stream streams[8];
+static uint32_t inject_flags;
+static uint32_t primask;
+
+static void host_delay_ms(uint32_t delay)
+{
+	host_mcu_stats.delay_ms += delay;
+}
+
+void (*ili9325_ptr_delay_ms)(uint32_t delay) = host_delay_ms;
+
+/**
+ * Takes the pending stream interrupts while PRIMASK is clear
+ */
+static void take_irqs(void)
+{
+	for (int i = 0; i < 8 && primask == 0; i++) {
+		if (!(streams[i].flags & streams[i].irq_mask)) continue;
+		host_mcu_stats.irqs++;
+#if ILI9325_USE_DMA
+		if (i == ILI9325_DMA_STREAM) {
+			DMA_ISR(ILI9325_DMA_STREAM)();
+			continue;
+		}
+#endif
+		fprintf(stderr, "host: no handler for DMA2 stream %d\n", i);
+		exit(2);
+	}
+}
+
+/**
+ * Transfers the running DMA chunks and takes their interrupts if PRIMASK allows
+ * @return: true if any chunk was transferred
+ */
+bool host_dma_run(void)
+{
+	bool ran = false;
+	for (int i = 0; i < 8; i++) {
+		struct dma_stream *s = &streams[i];
+		if (!s->enabled) continue;
+		ran = true;
+		s->enabled = false;
+		host_mcu_stats.chunks++;
+		if (inject_flags) {
+			s->flags |= inject_flags;
+			inject_flags = 0;
+			continue;
+		}
+		for (uint32_t n = 0; n < s->ndtr; n++) {
+			uint16_t item = *(volatile uint16_t *)(uintptr_t)(s->par + (s->pinc ? 2 * n : 0));
+			host_bus_store((volatile void *)(uintptr_t)(s->mar + (s->minc ? 2 * n : 0)), item);
+		}
+		host_mcu_stats.items += s->ndtr;
+		s->ndtr = 0;
+		s->flags |= DMA_TCIF;
+	}
+	take_irqs();
+	return ran;
+}
+
+/**
+ * Makes the next DMA chunk fail with the flags instead of transferring
+ * @flags: DMA_TEIF, DMA_FEIF or DMA_DMEIF
+ */
+void host_dma_inject(uint32_t flags)
+{
+	inject_flags = flags;
+}
+
+/**
+ * Stops DMA, clears PRIMASK and statistics
+ */
+void host_mcu_reset(void)
+{
+	memset(streams, 0, sizeof(streams));
+	memset(&host_mcu_stats, 0, sizeof(host_mcu_stats));
+	inject_flags = 0;
+	primask = 0;
+}
+
+void host_wfi(void)
+{
+	host_mcu_stats.wfi++;
+	for (int i = 0; i < 8; i++) {
+		if (streams[i].flags & streams[i].irq_mask) return;
+	}
+	if (!host_dma_run()) {
+		fprintf(stderr, "host: WFI with nothing to wake the core\n");
+		exit(2);
+	}
+}
+
+uint32_t host_get_primask(void)
+{
+	return primask;
+}
+
+void host_set_primask(uint32_t value)
+{
+	primask = value & 1;
+	take_irqs();
+}
+
+/*Character output of libprintf*/
+void _putchar(char character)
+{
+	putchar(character);
+}
+
+/*GPIO, pin.c drives RESET through them*/
+static uint32_t *gpio_reg(uint32_t gpioport, uint32_t off)
+{
+	uint32_t port = (gpioport - GPIO_PORT_A_BASE) / (GPIO_PORT_B_BASE - GPIO_PORT_A_BASE);
+	return &host_gpio[(port * 0x400 + off) / 4];
+}
+
+void gpio_set(uint32_t gpioport, uint16_t gpios)
+{
+	host_bus_stats.calls++;
+	*gpio_reg(gpioport, HOST_BUS_ODR) |= gpios;
+}
+
+void gpio_clear(uint32_t gpioport, uint16_t gpios)
+{
+	host_bus_stats.calls++;
+	*gpio_reg(gpioport, HOST_BUS_ODR) &= ~(uint32_t)gpios;
+}
+
+void gpio_toggle(uint32_t gpioport, uint16_t gpios)
+{
+	host_bus_stats.calls++;
+	*gpio_reg(gpioport, HOST_BUS_ODR) ^= gpios;
+}
+
+uint16_t gpio_get(uint32_t gpioport, uint16_t gpios)
+{
+	host_bus_stats.calls++;
+	return *gpio_reg(gpioport, HOST_BUS_IDR) & gpios;
+}
+
+uint16_t gpio_port_read(uint32_t gpioport)
+{
+	host_bus_stats.calls++;
+	return *gpio_reg(gpioport, HOST_BUS_IDR);
+}
+
+void gpio_port_write(uint32_t gpioport, uint16_t data)
+{
+	host_bus_stats.calls++;
+	*gpio_reg(gpioport, HOST_BUS_ODR) = data;
+}
+
+void rcc_periph_clock_enable(enum rcc_periph_clken clken)
+{
+	(void)clken;
+}
+
+void nvic_enable_irq(uint8_t irqn)
+{
+	(void)irqn;
+}
+
+/*DMA2 stream registers*/
+void dma_stream_reset(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream] = (struct dma_stream){0};
+}
+
+void dma_clear_interrupt_flags(uint32_t dma, uint8_t stream, uint32_t interrupts)
+{
+	(void)dma;
+	streams[stream].flags &= ~interrupts;
+}
+
+bool dma_get_interrupt_flag(uint32_t dma, uint8_t stream, uint32_t interrupt)
+{
+	(void)dma;
+	return (streams[stream].flags & interrupt) != 0;
+}
+
+void dma_set_transfer_mode(uint32_t dma, uint8_t stream, uint32_t direction)
+{
+	(void)dma;
+	if (direction != DMA_SxCR_DIR_MEM_TO_MEM) {
+		fprintf(stderr, "host: DMA2 stream %u is not memory-to-memory\n", stream);
+		exit(2);
+	}
+}
+
+void dma_set_priority(uint32_t dma, uint8_t stream, uint32_t prio)
+{
+	(void)dma; (void)stream; (void)prio;
+}
+
+void dma_set_memory_size(uint32_t dma, uint8_t stream, uint32_t mem_size)
+{
+	(void)dma; (void)stream; (void)mem_size;
+}
+
+void dma_set_peripheral_size(uint32_t dma, uint8_t stream, uint32_t peripheral_size)
+{
+	(void)dma; (void)stream; (void)peripheral_size;
+}
+
+void dma_enable_memory_increment_mode(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].minc = true;
+}
+
+void dma_disable_memory_increment_mode(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].minc = false;
+}
+
+void dma_enable_peripheral_increment_mode(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].pinc = true;
+}
+
+void dma_disable_peripheral_increment_mode(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].pinc = false;
+}
+
+void dma_enable_transfer_complete_interrupt(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].irq_mask |= DMA_TCIF;
+}
+
+void dma_enable_transfer_error_interrupt(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].irq_mask |= DMA_TEIF;
+}
+
+void dma_enable_fifo_error_interrupt(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].irq_mask |= DMA_FEIF;
+}
+
+void dma_enable_fifo_mode(uint32_t dma, uint8_t stream)
+{
+	(void)dma; (void)stream;
+}
+
+void dma_set_fifo_threshold(uint32_t dma, uint8_t stream, uint32_t threshold)
+{
+	(void)dma; (void)stream; (void)threshold;
+}
+
+void dma_enable_stream(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].enabled = true;
+	if (streams[stream].ndtr > host_mcu_stats.max_chunk) {
+		host_mcu_stats.max_chunk = streams[stream].ndtr;
+	}
+}
+
+void dma_disable_stream(uint32_t dma, uint8_t stream)
+{
+	(void)dma;
+	streams[stream].enabled = false;
+}
+
+void dma_set_peripheral_address(uint32_t dma, uint8_t stream, uint32_t address)
+{
+	(void)dma;
+	streams[stream].par = address;
+}
+
+void dma_set_memory_address(uint32_t dma, uint8_t stream, uint32_t address)
+{
+	(void)dma;
+	streams[stream].mar = address;
+}
+
+void dma_set_number_of_data(uint32_t dma, uint8_t stream, uint16_t number)
+{
+	(void)dma;
+	streams[stream].ndtr = number;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Host doubles of libopencm3 and the core.
+ *
+ * GPIO calls of pin.c, the DMA2 stream used by ili9325_async.c and PRIMASK. A started
+ * DMA chunk is transferred to the bus model on host_dma_run() or on WFI, then its flags
+ * are raised and the stream interrupt is taken once PRIMASK is clear.
+ */
+
+/*
+ * host_mcu_stats
+ * @wfi: WFI instructions
+ * @irqs: stream interrupts taken
+ * @chunks: DMA chunks transferred
+ * @items: DMA items transferred
+ * @max_chunk: the longest chunk (NDTR) started
+ * @delay_ms: ms waited through ili9325_ptr_delay_ms
+ */
+struct host_mcu_stats {
+	uint32_t wfi;
+	uint32_t irqs;
+	uint32_t chunks;
+	uint32_t items;
+	uint32_t max_chunk;
+	uint32_t delay_ms;
+};
+
+extern struct host_mcu_stats host_mcu_stats;
+
+void host_mcu_reset(void);
+bool host_dma_run(void);
+void host_dma_inject(uint32_t flags);
@@ -0,0 +1,105 @@
+/*
+ * Host ILI9325 model, see host_panel.h
+ */
+
+#include "host_panel.h"
+#include <stdbool.h>
+#include <string.h>
+
+struct host_panel_stats host_panel_stats;
+uint16_t host_panel_regs[256];
+uint16_t host_panel_gram[HOST_PANEL_V][HOST_PANEL_H];
+
+static uint16_t index_reg;
+static uint16_t ac_h, ac_v;
+static bool dummy_read;
+
+/**
+ * Moves the address counter after a GRAM access inside the window
+ */
+static void ac_advance(void)
+{
+	uint16_t entry = host_panel_regs[0x03];
+	bool am = entry & (1 << 3), inc_h = entry & (1 << 4), inc_v = entry & (1 << 5);
+	uint16_t hsa = host_panel_regs[0x50], hea = host_panel_regs[0x51];
+	uint16_t vsa = host_panel_regs[0x52], vea = host_panel_regs[0x53];
+	uint16_t *first = am ? &ac_v : &ac_h, *second = am ? &ac_h : &ac_v;
+	uint16_t first_sa = am ? vsa : hsa, first_ea = am ? vea : hea;
+	uint16_t second_sa = am ? hsa : vsa, second_ea = am ? hea : vea;
+	bool first_inc = am ? inc_v : inc_h, second_inc = am ? inc_h : inc_v;
+
+	if (first_inc ? *first < first_ea : *first > first_sa) {
+		*first += first_inc ? 1 : -1;
+		return;
+	}
+	*first = first_inc ? first_sa : first_ea;
+	if (second_inc ? *second < second_ea : *second > second_sa) {
+		*second += second_inc ? 1 : -1;
+	} else {
+		*second = second_inc ? second_sa : second_ea;
+	}
+}
+
+/**
+ * Puts the panel into its state after reset and clears GRAM and statistics
+ */
+void host_panel_reset(void)
+{
+	memset(host_panel_regs, 0, sizeof(host_panel_regs));
+	memset(host_panel_gram, 0, sizeof(host_panel_gram));
+	memset(&host_panel_stats, 0, sizeof(host_panel_stats));
+	host_panel_regs[0x03] = 0x0030;
+	host_panel_regs[0x51] = HOST_PANEL_H - 1;
+	host_panel_regs[0x53] = HOST_PANEL_V - 1;
+	index_reg = 0;
+	ac_h = ac_v = 0;
+	dummy_read = false;
+}
+
+void host_panel_write_cmd(uint16_t index)
+{
+	host_panel_stats.cmds++;
+	index_reg = index & 0xFF;
+	if (index_reg == 0x22) {
+		host_panel_stats.frames++;
+		dummy_read = true;
+	}
+}
+
+void host_panel_write_data(uint16_t data)
+{
+	if (index_reg == 0x22) {
+		host_panel_stats.pixels++;
+		if (ac_h < HOST_PANEL_H && ac_v < HOST_PANEL_V) host_panel_gram[ac_v][ac_h] = data;
+		ac_advance();
+		return;
+	}
+	host_panel_stats.regs++;
+	host_panel_regs[index_reg] = data;
+	if (index_reg == 0x20) ac_h = data & 0xFF;
+	if (index_reg == 0x21) ac_v = data & 0x1FF;
+}
+
+uint16_t host_panel_read(void)
+{
+	host_panel_stats.reads++;
+	if (index_reg != 0x22) return host_panel_regs[index_reg];
+	if (dummy_read) {
+		dummy_read = false;
+		return 0xDEAD;
+	}
+	uint16_t data = (ac_h < HOST_PANEL_H && ac_v < HOST_PANEL_V) ? host_panel_gram[ac_v][ac_h] : 0;
+	ac_advance();
+	return data;
+}
+
+/**
+ * Gets a pixel as the driver maps it in the default orientation (rotation 0,
+ * R03h = 1038h): x runs along vertical GRAM addresses, y along horizontal ones
+ * @x, @y: screen coordinates
+ * @return: pixel color
+ */
+uint16_t host_panel_pixel(uint16_t x, uint16_t y)
+{
+	return host_panel_gram[x][y];
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Host ILI9325 model.
+ *
+ * 240x320 GRAM behind the window (R50h..R53h) and address counter (R20h, R21h)
+ * registers. GRAM writes and reads after R22h move the counter as entry mode (R03h)
+ * tells. The first read after R22h returns a dummy word like the controller.
+ */
+
+#define HOST_PANEL_H    240     // Horizontal GRAM addresses (R20h)
+#define HOST_PANEL_V    320     // Vertical GRAM addresses (R21h)
+
+/*
+ * host_panel_stats
+ * @cmds: index (command) writes
+ * @regs: register writes other than GRAM
+ * @frames: GRAM accesses started, i.e. R22h index writes
+ * @pixels: GRAM writes
+ * @reads: GRAM reads, dummy ones included
+ */
+struct host_panel_stats {
+	uint32_t cmds;
+	uint32_t regs;
+	uint32_t frames;
+	uint32_t pixels;
+	uint32_t reads;
+};
+
+extern struct host_panel_stats host_panel_stats;
+extern uint16_t host_panel_regs[256];
+extern uint16_t host_panel_gram[HOST_PANEL_V][HOST_PANEL_H];
+
+void host_panel_reset(void);
+void host_panel_write_cmd(uint16_t index);
+void host_panel_write_data(uint16_t data);
+uint16_t host_panel_read(void);
+uint16_t host_panel_pixel(uint16_t x, uint16_t y);
@@ -0,0 +1,22 @@
+#pragma once
+
+/**
+ * Host replacement of inc/intrinsics.h
+ *
+ * PRIMASK is a variable of host_mcu.c. WFI runs the pending DMA transfer and the
+ * stream interrupt is taken as soon as PRIMASK is cleared, as on the core.
+ */
+
+#include <stdint.h>
+
+void host_wfi(void);
+uint32_t host_get_primask(void);
+void host_set_primask(uint32_t primask);
+
+static inline void __WFI(void) { host_wfi(); }
+static inline void __disable_irq(void) { host_set_primask(1); }
+static inline void __enable_irq(void) { host_set_primask(0); }
+static inline uint32_t __get_PRIMASK(void) { return host_get_primask(); }
+static inline void __set_PRIMASK(uint32_t primask) { host_set_primask(primask); }
+static inline void __DMB(void) {}
+static inline void __DSB(void) {}
@@ -0,0 +1,57 @@
+/*
+ * Host test checks and setup, see test.h
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "ili9325.h"
+#include <string.h>
+
+int test_failures = 0;
+
+/**
+ * Puts the bus, the panel and the MCU doubles into their reset state
+ */
+void host_reset(void)
+{
+	host_bus_reset();
+	host_panel_reset();
+	host_mcu_reset();
+}
+
+/**
+ * Resets the doubles and initializes the tft lib for 320x240 album panel like the demo,
+ * statistics are cleared after the initialization
+ */
+void host_tft_init(void)
+{
+	host_reset();
+	tft_init(320, 240, 0x0000);
+	host_stats_reset();
+}
+
+/**
+ * Clears the statistics of the bus, the panel and the MCU doubles and the bus log
+ */
+void host_stats_reset(void)
+{
+	memset(&host_bus_stats, 0, sizeof(host_bus_stats));
+	memset(&host_panel_stats, 0, sizeof(host_panel_stats));
+	memset(&host_mcu_stats, 0, sizeof(host_mcu_stats));
+	host_bus_log_reset();
+}
+
+/**
+ * Reports the result of the test program
+ * @name: test name
+ * @return: exit status, 0 if all checks passed
+ */
+int test_done(const char *name)
+{
+	if (test_failures) {
+		printf("%s: FAILED (%d)\n", name, test_failures);
+		return 1;
+	}
+	printf("%s: OK\n", name);
+	return 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "host_bus.h"
+#include "host_panel.h"
+#include "host_mcu.h"
+#include <stdio.h>
+
+/**
+ * Host test checks.
+ *
+ * A failed check prints its location and the test goes on, test_done() turns the
+ * failures into the exit status of the test program.
+ */
+
+extern int test_failures;
+
+#define CHECK(cond) do { \
+	if (!(cond)) { \
+		fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+		test_failures++; \
+	} \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+	long long _a = (long long)(actual), _e = (long long)(expected); \
+	if (_a != _e) { \
+		fprintf(stderr, "%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, \
+		        #actual, _a, _e); \
+		test_failures++; \
+	} \
+} while (0)
+
+void host_reset(void);
+void host_tft_init(void);
+void host_stats_reset(void);
+int test_done(const char *name);
@@ -0,0 +1,134 @@
+/*
+ * DMA transfers on FSMC bus: chunks above 65535 items are chained from the stream
+ * interrupt, a transfer or FIFO error ends the transfer with the callback and
+ * TFT_EUNKNOWN, ili9325_wait_idle() keeps PRIMASK of the caller and the next access to
+ * the controller comes after the transfer.
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "ili9325.h"
+#include "ili9325_async.h"
+#include "intrinsics.h"
+#include <libopencm3/stm32/dma.h>
+
+#define SCREEN_PIXELS   (320UL * 240)
+
+static uint16_t image[SCREEN_PIXELS];
+static int done_calls;
+
+static void done(void)
+{
+	done_calls++;
+}
+
+static void test_fill_chained(void)
+{
+	host_tft_init();
+	done_calls = 0;
+	tft_set_frame(0, 0, 319, 239);
+	CHECK_EQ(ili9325_fill_pixels_async(0x1234, SCREEN_PIXELS, done), TFT_EOK);
+	CHECK(ili9325_is_busy());
+	CHECK_EQ(host_panel_stats.pixels, 0);
+
+	ili9325_wait_idle();
+	CHECK(!ili9325_is_busy());
+	CHECK_EQ(done_calls, 1);
+	CHECK_EQ(ili9325_async_result(), TFT_EOK);
+	CHECK_EQ(host_mcu_stats.chunks, 2);
+	CHECK_EQ(host_mcu_stats.max_chunk, 65535);
+	CHECK_EQ(host_mcu_stats.items, SCREEN_PIXELS);
+	CHECK_EQ(host_panel_stats.pixels, SCREEN_PIXELS);
+	CHECK_EQ(host_panel_pixel(0, 0), 0x1234);
+	CHECK_EQ(host_panel_pixel(319, 239), 0x1234);
+	CHECK_EQ(host_get_primask(), 0);
+}
+
+static void test_write_chained(void)
+{
+	for (uint32_t i = 0; i < SCREEN_PIXELS; i++) image[i] = (uint16_t)(i * 7);
+	host_tft_init();
+	done_calls = 0;
+	tft_set_frame(0, 0, 319, 239);
+	CHECK_EQ(ili9325_write_pixels_async(image, SCREEN_PIXELS, done), TFT_EOK);
+	ili9325_wait_idle();
+	CHECK_EQ(done_calls, 1);
+	CHECK_EQ(host_mcu_stats.chunks, 2);
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < SCREEN_PIXELS; i++) {
+		mismatches += host_panel_pixel(i % 320, i / 320) != image[i];
+	}
+	CHECK_EQ(mismatches, 0);
+}
+
+static void test_error(uint32_t flags)
+{
+	host_tft_init();
+	done_calls = 0;
+	tft_set_frame(0, 0, 319, 239);
+	host_dma_inject(flags);
+	CHECK_EQ(ili9325_fill_pixels_async(0xFFFF, SCREEN_PIXELS, done), TFT_EOK);
+	ili9325_wait_idle();
+	CHECK(!ili9325_is_busy());
+	CHECK_EQ(done_calls, 1);
+	CHECK_EQ(ili9325_async_result(), TFT_EUNKNOWN);
+	CHECK_EQ(host_mcu_stats.chunks, 1);
+	CHECK_EQ(host_panel_stats.pixels, 0);
+
+	/*The next transfer starts clean*/
+	CHECK_EQ(ili9325_fill_pixels_async(0xFFFF, 10, done), TFT_EOK);
+	ili9325_wait_idle();
+	CHECK_EQ(done_calls, 2);
+	CHECK_EQ(ili9325_async_result(), TFT_EOK);
+}
+
+static void test_primask(void)
+{
+	host_tft_init();
+	/*Idle: nothing to wait for, PRIMASK is not touched*/
+	__disable_irq();
+	ili9325_wait_idle();
+	CHECK_EQ(host_get_primask(), 1);
+	__enable_irq();
+	ili9325_wait_idle();
+	CHECK_EQ(host_get_primask(), 0);
+	CHECK_EQ(host_mcu_stats.wfi, 0);
+
+	/*Busy: the interrupts are taken while waiting, PRIMASK is restored*/
+	tft_set_frame(0, 0, 319, 239);
+	ili9325_fill_pixels_async(0, SCREEN_PIXELS, NULL);
+	ili9325_wait_idle();
+	CHECK_EQ(host_get_primask(), 0);
+	CHECK_EQ(host_mcu_stats.irqs, 2);
+	CHECK(host_mcu_stats.wfi >= 2);
+}
+
+/*Commands and pixels after the transfer wait for it and land after it*/
+static void test_access_waits(void)
+{
+	host_tft_init();
+	tft_set_frame(0, 0, 319, 239);
+	ili9325_fill_pixels_async(0x00F0, SCREEN_PIXELS, NULL);
+	ili9325_draw_pixel(5, 5, 0xBEEF);
+	CHECK(!ili9325_is_busy());
+	CHECK_EQ(host_panel_pixel(5, 5), 0xBEEF);
+	CHECK_EQ(host_panel_pixel(6, 5), 0x00F0);
+
+	tft_set_frame(0, 0, 319, 239);
+	ili9325_fill_pixels_async(0x0F00, SCREEN_PIXELS, NULL);
+	tft_frame_draw_pixel(0xCAFE);
+	CHECK_EQ(host_panel_pixel(0, 0), 0xCAFE);
+	CHECK_EQ(host_panel_pixel(1, 0), 0x0F00);
+	CHECK_EQ(host_panel_stats.pixels, 1 + 2 * SCREEN_PIXELS + 1);
+}
+
+int main(void)
+{
+	test_fill_chained();
+	test_write_chained();
+	test_error(DMA_TEIF);
+	test_error(DMA_FEIF);
+	test_primask();
+	test_access_waits();
+	return test_done("test_async_dma");
+}
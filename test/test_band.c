@@ -0,0 +1,136 @@
+/*
+ * Band renderer: a scene rendered band by band gives the same panel pixels as the same
+ * scene drawn directly, sends one frame per band and keeps the clip of the caller.
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "tft_band.h"
+#include "tft_blend.h"
+#include "ili9325.h"
+#include "macro.h"
+#include <string.h>
+
+static uint16_t direct[HOST_PANEL_V][HOST_PANEL_H];
+static uint16_t image[2 + 48 * 40];
+
+static void scene(void *ctx)
+{
+	(void)ctx;
+	tft_fill_screen(0x0841);
+	tft_fill_rectangle(10, 10, 300, 30, 0xF800);
+	tft_fill_circle(160, 120, 70, 0x07E0);
+	tft_draw_circle(60, 180, 40, 3, 0xFFE0);
+	tft_fill_ellipse(250, 170, 50, 30, 0x001F);
+	tft_fill_round_rect(20, 60, 90, 60, 12, 0xF81F);
+	tft_draw_line(0, 0, 319, 239, 1, 0xFFFF);
+	tft_draw_line(319, 0, 0, 239, 3, 0x7BEF);
+	tft_draw_line(5, 100, 300, 130, 5, 0x07FF);
+	tft_fill_triangle(200, 20, 310, 100, 180, 110, 0xFC00);
+	tft_draw_rectangle(100, 150, 120, 60, 2, 0x8410);
+	tft_pic_from_flash(230, 60, image);
+	tft_blit(-20, 200, image, NULL);
+	tft_set_font(COURIER_NEW_12_BOLD, 0xFFFF, 0x0000);
+	tft_print_str(12, 222, "Band 0123 xyz");
+	tft_set_font(UBUNTU_14_PROP, 0xFFE0, 0x0010);
+	tft_print_str(150, 100, "Kerning AV Wa");
+	tft_fill_rect_blend(40, 40, 200, 150, 0x001F, 96);
+	tft_draw_circle_aa(250, 60, 35, 0xFFFF);
+	tft_draw_line_aa(10, 230, 310, 15, 0xF800);
+}
+
+static void render_direct(void)
+{
+	host_tft_init();
+	scene(NULL);
+	memcpy(direct, host_panel_gram, sizeof(direct));
+}
+
+static uint32_t mismatches(void)
+{
+	uint32_t n = 0;
+	for (uint16_t v = 0; v < HOST_PANEL_V; v++) {
+		for (uint16_t h = 0; h < HOST_PANEL_H; h++) n += host_panel_gram[v][h] != direct[v][h];
+	}
+	return n;
+}
+
+static void test_identity(void)
+{
+	render_direct();
+	host_tft_init();
+	CHECK_EQ(tft_band_render(scene, NULL), TFT_EOK);
+	CHECK_EQ(mismatches(), 0);
+	/*One frame and one burst per band*/
+	uint32_t rows = (uint32_t)TFT_BAND_WIDTH * TFT_BAND_HEIGHT / 320;
+	CHECK_EQ(host_panel_stats.frames, (240 + rows - 1) / rows);
+	CHECK_EQ(host_panel_stats.pixels, 320UL * 240);
+}
+
+/*The clip of the caller still applies inside the bands, it is not left pushed*/
+static void test_caller_clip(void)
+{
+	tft_rect clip = {50, 30, 269, 209};
+	host_tft_init();
+	tft_push_clip(&clip);
+	scene(NULL);
+	tft_pop_clip();
+	memcpy(direct, host_panel_gram, sizeof(direct));
+
+	host_tft_init();
+	tft_push_clip(&clip);
+	CHECK_EQ(tft_band_render(scene, NULL), TFT_EOK);
+	tft_rect after;
+	CHECK(tft_get_clip(&after));
+	CHECK_EQ(after.x1, clip.x1);
+	CHECK_EQ(after.y2, clip.y2);
+	tft_pop_clip();
+	/*tft_fill_screen() is not clipped, compare the clip area only*/
+	uint32_t n = 0;
+	for (uint16_t y = clip.y1; y <= clip.y2; y++) {
+		for (uint16_t x = clip.x1; x <= clip.x2; x++) n += host_panel_pixel(x, y) != direct[x][y];
+	}
+	CHECK_EQ(n, 0);
+	CHECK(tft_get_clip(&after));
+	CHECK_EQ(after.x2, 319);
+	CHECK_EQ(after.y2, 239);
+}
+
+/*Each pass sees its band as the clip area*/
+struct clip_log {
+	uint16_t n;
+	tft_rect clips[32];
+};
+
+static void log_clip(void *ctx)
+{
+	struct clip_log *log = ctx;
+	if (log->n < 32) tft_get_clip(&log->clips[log->n]);
+	log->n++;
+}
+
+static void test_band_clip(void)
+{
+	struct clip_log log = {0};
+	uint16_t rows = (uint32_t)TFT_BAND_WIDTH * TFT_BAND_HEIGHT / 320;
+	host_tft_init();
+	CHECK_EQ(tft_band_render(log_clip, &log), TFT_EOK);
+	CHECK_EQ(log.n, (240 + rows - 1) / rows);
+	for (uint16_t i = 0; i < log.n && i < 32; i++) {
+		CHECK_EQ(log.clips[i].x1, 0);
+		CHECK_EQ(log.clips[i].x2, 319);
+		CHECK_EQ(log.clips[i].y1, i * rows);
+		CHECK_EQ(log.clips[i].y2, min(i * rows + rows, 240) - 1);
+	}
+}
+
+int main(void)
+{
+	image[0] = 48;
+	image[1] = 40;
+	for (uint32_t i = 0; i < 48 * 40; i++) image[2 + i] = (uint16_t)(i * 0x2F1B);
+	test_identity();
+	test_caller_clip();
+	test_band_clip();
+	return test_done("test_band");
+}
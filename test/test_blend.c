@@ -0,0 +1,173 @@
+/*
+ * Alpha blending against a scalar reference: every channel is blended on its own as
+ * (fg * w + bg * (32 - w)) >> 5 with w = (alpha + 4) >> 3, mask pixels weigh
+ * (mask * w + 128) >> 8. The spread blends must match it bit for bit, on the panel
+ * (GRAM read-back) and with both chunk shapes of blend_area().
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "tft_blend.h"
+
+/*Reference blend of two colors with weight 0..32*/
+static uint16_t ref_blend(uint16_t fg, uint16_t bg, uint32_t w)
+{
+	uint32_t r = ((fg >> 11) * w + (bg >> 11) * (32 - w)) >> 5;
+	uint32_t g = (((fg >> 5) & 0x3F) * w + ((bg >> 5) & 0x3F) * (32 - w)) >> 5;
+	uint32_t b = ((fg & 0x1F) * w + (bg & 0x1F) * (32 - w)) >> 5;
+	return (uint16_t)(r << 11 | g << 5 | b);
+}
+
+static uint32_t ref_weight(uint8_t alpha)
+{
+	return (alpha + 4) >> 3;
+}
+
+/*Background with all channels changing across the screen*/
+static uint16_t back(uint16_t x, uint16_t y)
+{
+	return (uint16_t)((x * 0x9E37u) ^ (y * 0x3B5u));
+}
+
+static void fill_back(void)
+{
+	for (uint16_t x = 0; x < HOST_PANEL_V; x++) {
+		for (uint16_t y = 0; y < HOST_PANEL_H; y++) host_panel_gram[x][y] = back(x, y);
+	}
+}
+
+/*Colors with every channel at its ends and steps between*/
+static void test_blend_color(void)
+{
+	uint32_t mismatches = 0;
+	for (uint32_t fg = 0; fg < 0x10000; fg += 257) {
+		for (uint32_t bg = 0; bg < 0x10000; bg += 251) {
+			for (uint32_t alpha = 0; alpha < 256; alpha++) {
+				mismatches += tft_blend_color(fg, bg, alpha) != ref_blend(fg, bg, ref_weight(alpha));
+			}
+		}
+	}
+	CHECK_EQ(mismatches, 0);
+	CHECK_EQ(tft_blend_color(0xFFFF, 0x0000, 255), 0xFFFF);
+	CHECK_EQ(tft_blend_color(0xFFFF, 0x1234, 0), 0x1234);
+}
+
+/*Pixels of the rectangle are blended, the rest of the screen is untouched*/
+static uint32_t check_fill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color,
+		                   uint8_t alpha)
+{
+	uint32_t mismatches = 0;
+	for (uint16_t sy = 0; sy < 240; sy++) {
+		for (uint16_t sx = 0; sx < 320; sx++) {
+			bool in = sx >= x && sx < x + w && sy >= y && sy < y + h;
+			uint16_t expected = in ? ref_blend(color, back(sx, sy), ref_weight(alpha)) : back(sx, sy);
+			mismatches += host_panel_pixel(sx, sy) != expected;
+		}
+	}
+	return mismatches;
+}
+
+static void test_fill_rect(void)
+{
+	static const struct {
+		uint16_t x, y, w, h;
+		uint8_t alpha;
+	} rects[] = {
+		{10, 20, 7, 30, 128},		// Narrow: whole rows per chunk
+		{3, 100, 200, 9, 77},		// Wide: row segments
+		{290, 230, 50, 20, 200},	// Cut by the screen edge
+		{0, 0, 1, 1, 255},
+	};
+	for (uint32_t i = 0; i < sizeof(rects) / sizeof(rects[0]); i++) {
+		host_tft_init();
+		fill_back();
+		CHECK_EQ(tft_fill_rect_blend(rects[i].x, rects[i].y, rects[i].w, rects[i].h, 0xF81F,
+		                             rects[i].alpha), TFT_EOK);
+		uint16_t w = (rects[i].x + rects[i].w > 320) ? 320 - rects[i].x : rects[i].w;
+		uint16_t h = (rects[i].y + rects[i].h > 240) ? 240 - rects[i].y : rects[i].h;
+		CHECK_EQ(check_fill(rects[i].x, rects[i].y, w, h, 0xF81F, rects[i].alpha), 0);
+	}
+}
+
+/*Blending honours the clip rectangle*/
+static void test_fill_clip(void)
+{
+	host_tft_init();
+	fill_back();
+	CHECK_EQ(tft_push_clip(&(tft_rect){50, 60, 69, 89}), TFT_EOK);
+	CHECK_EQ(tft_fill_rect_blend(40, 40, 100, 100, 0x07E0, 100), TFT_EOK);
+	CHECK_EQ(tft_pop_clip(), TFT_EOK);
+	CHECK_EQ(check_fill(50, 60, 20, 30, 0x07E0, 100), 0);
+}
+
+/*Mask of every format with weights from the reference, a zero weight keeps the pixel*/
+static void test_fill_mask(void)
+{
+	enum {W = 83, H = 11};
+	static uint8_t a8[W * H], a4[(W + 1) / 2 * H], a1[(W + 7) / 8 * H];
+	static const enum tft_alpha_fmt fmts[] = {TFT_ALPHA_A8, TFT_ALPHA_A4, TFT_ALPHA_A1};
+	const uint8_t *masks[] = {a8, a4, a1};
+
+	for (uint32_t i = 0; i < sizeof(a8); i++) a8[i] = (uint8_t)(i * 37);
+	for (uint32_t i = 0; i < sizeof(a4); i++) a4[i] = (uint8_t)(i * 73);
+	for (uint32_t i = 0; i < sizeof(a1); i++) a1[i] = (uint8_t)(i * 151);
+
+	for (uint32_t f = 0; f < 3; f++) {
+		for (uint32_t alpha = 0; alpha < 256; alpha += 51) {
+			host_tft_init();
+			fill_back();
+			tft_err err = tft_fill_mask_blend(100, 120, W, H, masks[f], fmts[f], 0xFD20, alpha);
+			CHECK_EQ(err, TFT_EOK);
+			uint32_t mismatches = 0;
+			for (uint16_t y = 0; y < H; y++) {
+				for (uint16_t x = 0; x < W; x++) {
+					uint32_t w = (tft_mask_alpha(masks[f], fmts[f], W, x, y) * ref_weight(alpha) + 128) >> 8;
+					uint16_t bg = back(100 + x, 120 + y);
+					uint16_t expected = w ? ref_blend(0xFD20, bg, w) : bg;
+					mismatches += host_panel_pixel(100 + x, 120 + y) != expected;
+				}
+			}
+			CHECK_EQ(mismatches, 0);
+		}
+	}
+}
+
+/*Picture pixels blended through a mask*/
+static void test_pic(void)
+{
+	enum {W = 70, H = 5};
+	static uint16_t img[2 + W * H];
+	static uint8_t mask[W * H];
+
+	img[0] = W;
+	img[1] = H;
+	for (uint32_t i = 0; i < W * H; i++) {
+		img[2 + i] = (uint16_t)(i * 0x4F1B);
+		mask[i] = (uint8_t)(i * 13);
+	}
+	host_tft_init();
+	fill_back();
+	CHECK_EQ(tft_pic_blend(5, 7, img, NULL, TFT_ALPHA_A8, 170), TFT_EOK);
+	CHECK_EQ(tft_pic_blend(5, 17, img, mask, TFT_ALPHA_A8, 255), TFT_EOK);
+	uint32_t mismatches = 0;
+	for (uint16_t y = 0; y < H; y++) {
+		for (uint16_t x = 0; x < W; x++) {
+			uint16_t fg = img[2 + y * W + x];
+			mismatches += host_panel_pixel(5 + x, 7 + y) != ref_blend(fg, back(5 + x, 7 + y), ref_weight(170));
+			uint32_t w = (mask[y * W + x] * ref_weight(255) + 128) >> 8;
+			uint16_t bg = back(5 + x, 17 + y);
+			mismatches += host_panel_pixel(5 + x, 17 + y) != (w ? ref_blend(fg, bg, w) : bg);
+		}
+	}
+	CHECK_EQ(mismatches, 0);
+}
+
+int main(void)
+{
+	test_blend_color();
+	test_fill_rect();
+	test_fill_clip();
+	test_fill_mask();
+	test_pic();
+	return test_done("test_blend");
+}
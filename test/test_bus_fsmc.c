@@ -0,0 +1,100 @@
+/*
+ * FSMC bus: a command is one store to the bank base, a data word one store to the
+ * address with the RS line (A16 by default) set. Nothing else touches the bus.
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "ili9325.h"
+
+#define FSMC_DATA_OFFSET    (1UL << (ILI9325_FSMC_RS_LINE + 1))
+
+static const uint16_t pixels[] = {0xF800, 0x07E0, 0x001F, 0xFFFF, 0x0000, 0x1234};
+#define N_PIXELS    (sizeof(pixels) / sizeof(pixels[0]))
+
+static void check_event(uint32_t i, int off, uint32_t value)
+{
+	CHECK(i < host_bus_log_len);
+	CHECK_EQ(host_bus_log[i].port, HOST_BUS_FSMC);
+	CHECK_EQ(host_bus_log[i].load, 0);
+	CHECK_EQ(host_bus_log[i].off, off);
+	CHECK_EQ(host_bus_log[i].value, value);
+}
+
+static void test_addresses(void)
+{
+	CHECK_EQ((uintptr_t)host_fsmc % (2 * FSMC_DATA_OFFSET), 0);
+}
+
+static void test_write_reg(void)
+{
+	host_tft_init();
+	ili9325_set_scroll(5);
+	CHECK_EQ(host_bus_log_len, 4);
+	check_event(0, HOST_BUS_FSMC_CMD, 0x61);
+	check_event(1, HOST_BUS_FSMC_DATA, 0x0003);
+	check_event(2, HOST_BUS_FSMC_CMD, 0x6A);
+	check_event(3, HOST_BUS_FSMC_DATA, 5);
+	CHECK_EQ(host_panel_regs[0x6A], 5);
+}
+
+static void test_set_frame(void)
+{
+	host_tft_init();
+	ili9325_frame_cache_invalidate();
+	ili9325_set_frame(10, 20, 30, 40);
+	/*Window registers take y in horizontal and x in vertical GRAM addresses*/
+	const uint16_t expected[][2] = {
+		{0x50, 20}, {0x51, 40}, {0x52, 10}, {0x53, 30}, {0x20, 20}, {0x21, 10},
+	};
+	CHECK_EQ(host_bus_log_len, 2 * 6 + 1);
+	for (uint32_t i = 0; i < 6; i++) {
+		check_event(2 * i, HOST_BUS_FSMC_CMD, expected[i][0]);
+		check_event(2 * i + 1, HOST_BUS_FSMC_DATA, expected[i][1]);
+	}
+	check_event(12, HOST_BUS_FSMC_CMD, 0x22);
+}
+
+static void test_pixels(void)
+{
+	host_tft_init();
+	ili9325_set_frame(100, 50, 100 + N_PIXELS - 1, 50);
+	host_stats_reset();
+	ili9325_write_pixels(pixels, N_PIXELS);
+	for (uint32_t i = 0; i < N_PIXELS; i++) {
+		check_event(i, HOST_BUS_FSMC_DATA, pixels[i]);
+		CHECK_EQ(host_panel_pixel(100 + i, 50), pixels[i]);
+	}
+	/*The address counter wraps to the window start*/
+	ili9325_fill_pixels(0x0F0F, 3);
+	CHECK_EQ(host_bus_log_len, N_PIXELS + 3);
+	for (uint32_t i = 0; i < 3; i++) {
+		check_event(N_PIXELS + i, HOST_BUS_FSMC_DATA, 0x0F0F);
+		CHECK_EQ(host_panel_pixel(100 + i, 50), 0x0F0F);
+	}
+	CHECK_EQ(host_bus_stats.calls, 0);
+	CHECK_EQ(host_bus_stats.loads, 0);
+}
+
+static void test_read_pixels(void)
+{
+	uint16_t back[N_PIXELS];
+	host_tft_init();
+	ili9325_set_frame(0, 0, N_PIXELS - 1, 0);
+	ili9325_write_pixels(pixels, N_PIXELS);
+	host_stats_reset();
+	CHECK_EQ(ili9325_read_pixels(0, 0, N_PIXELS, 1, back), TFT_EOK);
+	for (uint32_t i = 0; i < N_PIXELS; i++) CHECK_EQ(back[i], pixels[i]);
+	/*Dummy read first*/
+	CHECK_EQ(host_bus_stats.loads, N_PIXELS + 1);
+}
+
+int main(void)
+{
+	test_addresses();
+	test_write_reg();
+	test_set_frame();
+	test_pixels();
+	test_read_pixels();
+	return test_done("test_bus_fsmc");
+}
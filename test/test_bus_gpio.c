@@ -0,0 +1,139 @@
+/*
+ * GPIO bus: every pixel of a GRAM burst is one data port store and a WR strobe of two
+ * BSRR stores, RS and CS stay put and no library calls are made.
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "ili9325.h"
+#include "pin.h"
+
+#define WR_LOW      (1UL << (WR_PIN + 16))
+#define WR_HIGH     (1UL << WR_PIN)
+#define SELECT_CMD  ((1UL << (RS_PIN + 16)) | (1UL << (CS_PIN + 16)))
+#define SELECT_DATA ((1UL << RS_PIN) | (1UL << (CS_PIN + 16)))
+#define DESELECT    (1UL << CS_PIN)
+
+static const uint16_t pixels[] = {0xF800, 0x07E0, 0x001F, 0xFFFF, 0x0000, 0x1234, 0xABCD, 0x8001};
+#define N_PIXELS    (sizeof(pixels) / sizeof(pixels[0]))
+
+static void check_event(uint32_t i, int port, int off, uint32_t value)
+{
+	CHECK(i < host_bus_log_len);
+	CHECK_EQ(host_bus_log[i].load, 0);
+	CHECK_EQ(host_bus_log[i].port, port);
+	CHECK_EQ(host_bus_log[i].off, off);
+	CHECK_EQ(host_bus_log[i].value, value);
+}
+
+/*A pixel inside the burst is exactly: data port, WR low, WR high*/
+static void check_pixel(uint32_t i, uint16_t color)
+{
+	check_event(3 * i, PORT_DATA, HOST_BUS_ODR, color);
+	check_event(3 * i + 1, PORT_CTRL, HOST_BUS_BSRR, WR_LOW);
+	check_event(3 * i + 2, PORT_CTRL, HOST_BUS_BSRR, WR_HIGH);
+}
+
+static void test_write_pixels(void)
+{
+	host_tft_init();
+	ili9325_set_frame(10, 20, 10 + N_PIXELS - 1, 20);
+	ili9325_write_pixels_begin();
+	host_stats_reset();
+	ili9325_write_pixels(pixels, N_PIXELS);
+
+	CHECK_EQ(host_bus_log_len, 3 * N_PIXELS);
+	for (uint32_t i = 0; i < N_PIXELS; i++) {
+		check_pixel(i, pixels[i]);
+		CHECK_EQ(host_panel_pixel(10 + i, 20), pixels[i]);
+	}
+	CHECK_EQ(host_bus_stats.strobes, N_PIXELS);
+	CHECK_EQ(host_bus_stats.loads, 0);
+	CHECK_EQ(host_bus_stats.calls, 0);
+	ili9325_write_pixels_end();
+	check_event(3 * N_PIXELS, PORT_CTRL, HOST_BUS_BSRR, DESELECT);
+}
+
+static void test_frame_draw_pixel(void)
+{
+	host_tft_init();
+	tft_set_frame(0, 5, N_PIXELS - 1, 5);
+	ili9325_write_pixels_begin();
+	host_stats_reset();
+	for (uint32_t i = 0; i < N_PIXELS; i++) tft_frame_draw_pixel(pixels[i]);
+
+	CHECK_EQ(host_bus_log_len, 3 * N_PIXELS);
+	for (uint32_t i = 0; i < N_PIXELS; i++) {
+		check_pixel(i, pixels[i]);
+		CHECK_EQ(host_panel_pixel(i, 5), pixels[i]);
+	}
+	ili9325_write_pixels_end();
+}
+
+/*A fill puts the color on the data port once, then only strobes WR*/
+static void test_fill_pixels(void)
+{
+	host_tft_init();
+	ili9325_set_frame(0, 0, 99, 0);
+	ili9325_write_pixels_begin();
+	host_stats_reset();
+	ili9325_fill_pixels(0x5AA5, 100);
+
+	CHECK_EQ(host_bus_log_len, 1 + 2 * 100);
+	check_event(0, PORT_DATA, HOST_BUS_ODR, 0x5AA5);
+	for (uint32_t i = 0; i < 100; i++) {
+		check_event(1 + 2 * i, PORT_CTRL, HOST_BUS_BSRR, WR_LOW);
+		check_event(2 + 2 * i, PORT_CTRL, HOST_BUS_BSRR, WR_HIGH);
+		CHECK_EQ(host_panel_pixel(i, 0), 0x5AA5);
+	}
+	CHECK_EQ(host_panel_stats.pixels, 100);
+	ili9325_write_pixels_end();
+}
+
+/*Command and register writes select RS and CS with one BSRR store*/
+static void test_write_reg(void)
+{
+	host_tft_init();
+	ili9325_set_scroll(0);
+	const uint32_t expected[][3] = {
+		{PORT_CTRL, HOST_BUS_BSRR, SELECT_CMD},
+		{PORT_DATA, HOST_BUS_ODR, 0x61},
+		{PORT_CTRL, HOST_BUS_BSRR, WR_LOW},
+		{PORT_CTRL, HOST_BUS_BSRR, WR_HIGH},
+		{PORT_CTRL, HOST_BUS_BSRR, DESELECT},
+		{PORT_CTRL, HOST_BUS_BSRR, SELECT_DATA},
+		{PORT_DATA, HOST_BUS_ODR, 0x0001},
+		{PORT_CTRL, HOST_BUS_BSRR, WR_LOW},
+		{PORT_CTRL, HOST_BUS_BSRR, WR_HIGH},
+		{PORT_CTRL, HOST_BUS_BSRR, DESELECT},
+	};
+	for (uint32_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+		check_event(i, expected[i][0], expected[i][1], expected[i][2]);
+	}
+	CHECK_EQ(host_bus_stats.calls, 0);
+	CHECK_EQ(host_panel_regs[0x61], 0x0001);
+}
+
+/*Pixels drawn one by one outside of a burst land where tft_draw_point() puts them*/
+static void test_draw_pixel(void)
+{
+	host_tft_init();
+	ili9325_draw_pixel(319, 239, 0xF00F);
+	ili9325_draw_pixel(0, 239, 0x0FF0);
+	ili9325_draw_pixel(319, 0, 0x00FF);
+	CHECK_EQ(host_panel_pixel(319, 239), 0xF00F);
+	CHECK_EQ(host_panel_pixel(0, 239), 0x0FF0);
+	CHECK_EQ(host_panel_pixel(319, 0), 0x00FF);
+	CHECK_EQ(host_panel_stats.pixels, 3);
+	CHECK_EQ(host_bus_stats.faults, 0);
+}
+
+int main(void)
+{
+	test_write_pixels();
+	test_frame_draw_pixel();
+	test_fill_pixels();
+	test_write_reg();
+	test_draw_pixel();
+	return test_done("test_bus_gpio");
+}
@@ -0,0 +1,81 @@
+/*
+ * GRAM read-back on GPIO bus: the dummy word after R22h is dropped, the data port is
+ * input only while RD strobes and pixels come back as they were written.
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "ili9325.h"
+#include "pin.h"
+
+static uint16_t pattern[40 * 30];
+static uint16_t back[40 * 30];
+
+static void test_round_trip(void)
+{
+	for (uint32_t i = 0; i < 40 * 30; i++) pattern[i] = (uint16_t)(i * 0x9E37);
+	host_tft_init();
+	tft_set_frame(100, 50, 139, 79);
+	tft_write_pixels(pattern, 40 * 30);
+	host_stats_reset();
+
+	CHECK_EQ(ili9325_read_pixels(100, 50, 40, 30, back), TFT_EOK);
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < 40 * 30; i++) mismatches += back[i] != pattern[i];
+	CHECK_EQ(mismatches, 0);
+	CHECK_EQ(host_bus_stats.reads, 40 * 30 + 1);
+	CHECK_EQ(host_panel_stats.reads, 40 * 30 + 1);
+	CHECK_EQ(host_bus_stats.faults, 0);
+	/*Data port is output again*/
+	CHECK_EQ(host_gpio[(PORT_DATA * 0x400 + HOST_BUS_MODER) / 4], 0x55555555UL);
+}
+
+/*A sub-rectangle and a single pixel of what was drawn*/
+static void test_sub_rect(void)
+{
+	host_tft_init();
+	tft_set_frame(100, 50, 139, 79);
+	tft_write_pixels(pattern, 40 * 30);
+	ili9325_draw_pixel(319, 239, 0x4321);
+
+	CHECK_EQ(tft_read_pixels(110, 60, 5, 3, back), TFT_EOK);
+	for (uint32_t y = 0; y < 3; y++) {
+		for (uint32_t x = 0; x < 5; x++) {
+			CHECK_EQ(back[y * 5 + x], pattern[(10 + y) * 40 + 10 + x]);
+		}
+	}
+	CHECK_EQ(tft_read_pixels(319, 239, 1, 1, back), TFT_EOK);
+	CHECK_EQ(back[0], 0x4321);
+}
+
+/*Writes after a read go to the right place again*/
+static void test_write_after_read(void)
+{
+	host_tft_init();
+	CHECK_EQ(ili9325_read_pixels(0, 0, 10, 10, back), TFT_EOK);
+	tft_set_frame(0, 0, 9, 0);
+	tft_fill_pixels(0x7777, 10);
+	CHECK_EQ(host_panel_pixel(0, 0), 0x7777);
+	CHECK_EQ(host_panel_pixel(9, 0), 0x7777);
+	CHECK_EQ(host_panel_pixel(0, 1), 0x0000);
+	CHECK_EQ(host_bus_stats.faults, 0);
+}
+
+static void test_args(void)
+{
+	host_tft_init();
+	CHECK_EQ(ili9325_read_pixels(0, 0, 1, 1, NULL), TFT_EWRONGARG);
+	CHECK_EQ(ili9325_read_pixels(0, 0, 0, 1, back), TFT_EWRONGARG);
+	CHECK_EQ(ili9325_read_pixels(310, 0, 11, 1, back), TFT_ERANGE);
+	CHECK_EQ(ili9325_read_pixels(0, 239, 1, 2, back), TFT_ERANGE);
+	CHECK_EQ(host_bus_stats.stores, 0);
+}
+
+int main(void)
+{
+	test_round_trip();
+	test_sub_rect();
+	test_write_after_read();
+	test_args();
+	return test_done("test_read_pixels");
+}
@@ -0,0 +1,89 @@
+/*
+ * Sprites over a patterned background: the picture is drawn where it is visible, moves
+ * leave the background as it was and only pixels inside the clip rectangle are touched.
+ */
+
+#include "test.h"
+#include "tft.h"
+#include "tft_sprite.h"
+
+#define SIZE	20
+
+static uint16_t img[2 + SIZE * SIZE];
+static uint16_t back_buf[SIZE * SIZE];
+
+/*Empty clip, nothing of the sprite is expected*/
+static const tft_rect none = {1, 1, 0, 0};
+
+static uint16_t back(uint16_t x, uint16_t y)
+{
+	return (uint16_t)((x * 0x9E37u) ^ (y * 0x3B5u));
+}
+
+static void fill_back(void)
+{
+	for (uint16_t x = 0; x < HOST_PANEL_V; x++) {
+		for (uint16_t y = 0; y < HOST_PANEL_H; y++) host_panel_gram[x][y] = back(x, y);
+	}
+}
+
+/*Screen pixels differing from the sprite at x, y limited to c over the background*/
+static uint32_t check_screen(int16_t x, int16_t y, const tft_rect *c)
+{
+	uint32_t mismatches = 0;
+	for (int32_t sy = 0; sy < 240; sy++) {
+		for (int32_t sx = 0; sx < 320; sx++) {
+			bool in = sx >= x && sx < x + SIZE && sy >= y && sy < y + SIZE &&
+			          sx >= c->x1 && sx <= c->x2 && sy >= c->y1 && sy <= c->y2;
+			uint16_t expected = in ? img[2 + (sy - y) * SIZE + (sx - x)] : back(sx, sy);
+			mismatches += host_panel_pixel(sx, sy) != expected;
+		}
+	}
+	return mismatches;
+}
+
+static void test_move(void)
+{
+	static const tft_rect screen = {0, 0, 319, 239};
+	static const int16_t path[][2] = {{50, 50}, {55, 47}, {80, 80}, {310, 230}, {-5, -8}, {0, 0}};
+	tft_sprite s;
+
+	host_tft_init();
+	fill_back();
+	CHECK_EQ(tft_sprite_init(&s, img, back_buf), TFT_EOK);
+	for (uint32_t i = 0; i < sizeof(path) / sizeof(path[0]); i++) {
+		CHECK_EQ(tft_sprite_move(&s, path[i][0], path[i][1]), TFT_EOK);
+		CHECK_EQ(check_screen(path[i][0], path[i][1], &screen), 0);
+	}
+	CHECK_EQ(tft_sprite_hide(&s), TFT_EOK);
+	CHECK_EQ(check_screen(0, 0, &none), 0);
+}
+
+/*Under a clip the sprite is cut to it and the background outside stays as it was*/
+static void test_clip(void)
+{
+	static const tft_rect clip = {60, 40, 99, 79};
+	static const int16_t path[][2] = {{50, 30}, {55, 35}, {90, 70}, {92, 66}, {120, 120}, {45, 60}};
+	tft_sprite s;
+
+	host_tft_init();
+	fill_back();
+	CHECK_EQ(tft_sprite_init(&s, img, back_buf), TFT_EOK);
+	CHECK_EQ(tft_push_clip(&clip), TFT_EOK);
+	for (uint32_t i = 0; i < sizeof(path) / sizeof(path[0]); i++) {
+		CHECK_EQ(tft_sprite_move(&s, path[i][0], path[i][1]), TFT_EOK);
+		CHECK_EQ(check_screen(path[i][0], path[i][1], &clip), 0);
+	}
+	CHECK_EQ(tft_sprite_hide(&s), TFT_EOK);
+	CHECK_EQ(tft_pop_clip(), TFT_EOK);
+	CHECK_EQ(check_screen(0, 0, &none), 0);
+}
+
+int main(void)
+{
+	img[0] = img[1] = SIZE;
+	for (uint32_t i = 0; i < SIZE * SIZE; i++) img[2 + i] = (uint16_t)(i * 0x4F1B + 1);
+	test_move();
+	test_clip();
+	return test_done("test_sprite");
+}